@@ -8,15 +8,42 @@ TARGET = TicTacToe
 TEMPLATE = app
 
 SOURCES += \
+    src/connectionpool.cpp \
+    src/databasetuning.cpp \
+    src/databaseworker.cpp \
+    src/evaluator.cpp \
+    src/gameanalyzer.cpp \
+    src/gamehistorymodel.cpp \
+    src/gamevalidator.cpp \
     src/main.cpp \
     src/mainwindow.cpp \
+    src/qubicgame.cpp \
+    src/resultjournal.cpp \
+    src/searchtask.cpp \
     src/tictactoegame.cpp \
+    src/trainingexport.cpp \
+    src/transpositiontable.cpp \
+    src/ultimatetictactoe.cpp \
     src/user.cpp \
     src/usermanager.cpp
 
 HEADERS += \
+    src/connectionpool.h \
+    src/databasetuning.h \
+    src/databaseworker.h \
+    src/evaluator.h \
+    src/gameanalyzer.h \
+    src/gamehistorymodel.h \
+    src/gamevalidator.h \
     src/mainwindow.h \
+    src/qubicgame.h \
+    src/resultjournal.h \
+    src/rulevariants.h \
+    src/searchtask.h \
     src/tictactoegame.h \
+    src/trainingexport.h \
+    src/transpositiontable.h \
+    src/ultimatetictactoe.h \
     src/user.h \
     src/usermanager.h
 
@@ -0,0 +1,63 @@
+#include "connectionpool.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+
+#include "databasetuning.h"
+
+namespace {
+// Users of each of this thread's connections, by connection name
+thread_local QHash<QString, int> useCounts;
+}  // namespace
+
+QString ConnectionPool::connectionName(const QString& path,
+                                      const QString& owner) {
+  QString name = QString("tictactoe:%1@%2")
+                     .arg(QFileInfo(path).absoluteFilePath())
+                     .arg(quintptr(QThread::currentThreadId()), 0, 16);
+  if (!owner.isEmpty()) name += "/" + owner;
+  return name;
+}
+
+QSqlDatabase ConnectionPool::acquire(const QString& path,
+                                     const QString& owner) {
+  QString name = connectionName(path, owner);
+  int& count = useCounts[name];
+  if (count++ > 0) return QSqlDatabase::database(name);
+
+  // Left over by a finished thread whose id has been reused
+  if (QSqlDatabase::contains(name)) QSqlDatabase::removeDatabase(name);
+
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", name);
+  db.setDatabaseName(path);
+  if (!db.open()) {
+    qDebug() << "Error opening database:" << db.lastError().text();
+    return db;
+  }
+
+  // busy_timeout, cache and temp_store settings live on the connection,
+  // so each thread's connection starts without them
+  const DatabaseTuning tuning = DatabaseTuning::forDatabase(path);
+  QSqlQuery query(db);
+  for (const QString& pragma : tuning.connectionPragmas()) {
+    if (!query.exec(pragma))
+      qDebug() << "Error applying" << pragma << ":" << query.lastError().text();
+  }
+  query.finish();
+  return db;
+}
+
+void ConnectionPool::release(const QString& path, const QString& owner) {
+  QString name = connectionName(path, owner);
+  auto it = useCounts.find(name);
+  if (it == useCounts.end()) return;
+  if (--it.value() > 0) return;
+
+  useCounts.erase(it);
+  QSqlDatabase::database(name, false).close();
+  QSqlDatabase::removeDatabase(name);
+}
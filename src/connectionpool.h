@@ -0,0 +1,49 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// Named SQLite connections, one per database file per thread. A
+// QSqlDatabase may only be used on the thread that opened it, so every
+// thread that touches the database gets its own; under WAL they read
+// concurrently while one of them writes.
+//
+// A connection has one transaction state, so a holder that keeps a
+// transaction open across calls (UserManager's batches) passes an owner
+// tag and gets a connection of its own instead of the thread's shared one.
+class ConnectionPool {
+ public:
+  // The calling thread's connection to path for owner, opened on first
+  // use and given the per-connection settings of DatabaseTuning. Each
+  // acquire needs a release with the same arguments on the same thread,
+  // and the last release closes the connection; drop every QSqlDatabase
+  // copy before it.
+  static QSqlDatabase acquire(const QString& path,
+                              const QString& owner = QString());
+  static void release(const QString& path, const QString& owner = QString());
+
+  static QString connectionName(const QString& path,
+                                const QString& owner = QString());
+};
+
+// Holds the calling thread's connection for the lifetime of the object
+class PooledConnection {
+ public:
+  explicit PooledConnection(const QString& path)
+      : path(path), db(ConnectionPool::acquire(path)) {}
+  ~PooledConnection() {
+    db = QSqlDatabase();
+    ConnectionPool::release(path);
+  }
+  PooledConnection(const PooledConnection&) = delete;
+  PooledConnection& operator=(const PooledConnection&) = delete;
+
+  QSqlDatabase& database() { return db; }
+
+ private:
+  QString path;
+  QSqlDatabase db;
+};
+
+#endif  // CONNECTIONPOOL_H
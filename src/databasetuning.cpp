@@ -0,0 +1,61 @@
+#include "databasetuning.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QSettings>
+
+namespace {
+// PRAGMA values are spliced into SQL, so only known keywords are accepted
+QString pragmaKeyword(QSettings& settings, const QString& key,
+                      const QString& fallback, const QStringList& allowed) {
+  QString value = settings.value(key, fallback).toString().toUpper();
+  if (allowed.contains(value)) return value;
+  qDebug() << "Ignoring invalid sqlite setting" << key << "=" << value;
+  return fallback;
+}
+
+qint64 pragmaNumber(QSettings& settings, const QString& key, qint64 fallback) {
+  bool ok = false;
+  qint64 value = settings.value(key, fallback).toLongLong(&ok);
+  if (ok && value >= 0) return value;
+  qDebug() << "Ignoring invalid sqlite setting" << key;
+  return fallback;
+}
+}  // namespace
+
+DatabaseTuning DatabaseTuning::fromSettings(const QString& path) {
+  DatabaseTuning tuning;
+  QSettings settings(path, QSettings::IniFormat);
+  settings.beginGroup("sqlite");
+  tuning.journalMode = pragmaKeyword(
+      settings, "journal_mode", tuning.journalMode,
+      {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL"});
+  tuning.synchronous = pragmaKeyword(settings, "synchronous",
+                                     tuning.synchronous,
+                                     {"OFF", "NORMAL", "FULL", "EXTRA"});
+  tuning.tempStore = pragmaKeyword(settings, "temp_store", tuning.tempStore,
+                                   {"DEFAULT", "FILE", "MEMORY"});
+  tuning.cacheSizeKiB =
+      int(pragmaNumber(settings, "cache_size_kib", tuning.cacheSizeKiB));
+  tuning.mmapSize = pragmaNumber(settings, "mmap_size", tuning.mmapSize);
+  tuning.busyTimeoutMs =
+      int(pragmaNumber(settings, "busy_timeout_ms", tuning.busyTimeoutMs));
+  return tuning;
+}
+
+DatabaseTuning DatabaseTuning::forDatabase(const QString& dbPath) {
+  return fromSettings(QFileInfo(dbPath).absolutePath() + "/sqlite.ini");
+}
+
+QStringList DatabaseTuning::connectionPragmas() const {
+  return {"PRAGMA synchronous = " + synchronous,
+          QString("PRAGMA cache_size = -%1").arg(cacheSizeKiB),
+          QString("PRAGMA mmap_size = %1").arg(mmapSize),
+          "PRAGMA temp_store = " + tempStore,
+          QString("PRAGMA busy_timeout = %1").arg(busyTimeoutMs)};
+}
+
+QStringList DatabaseTuning::pragmas() const {
+  return QStringList("PRAGMA journal_mode = " + journalMode) +
+         connectionPragmas();
+}
@@ -0,0 +1,30 @@
+#ifndef DATABASETUNING_H
+#define DATABASETUNING_H
+
+#include <QString>
+#include <QStringList>
+
+// SQLite settings applied whenever the database is opened. Defaults suit
+// the desktop app: WAL so game-end saves don't block readers, and NORMAL
+// sync, which is crash-safe under WAL. A deployment can override any field
+// in the [sqlite] group of sqlite.ini next to the database.
+struct DatabaseTuning {
+  QString journalMode = "WAL";     // DELETE, TRUNCATE, PERSIST, MEMORY, WAL
+  QString synchronous = "NORMAL";  // OFF, NORMAL, FULL, EXTRA
+  int cacheSizeKiB = 8192;
+  qint64 mmapSize = 64LL * 1024 * 1024;
+  QString tempStore = "MEMORY";  // DEFAULT, FILE, MEMORY
+  int busyTimeoutMs = 5000;
+
+  // Missing or invalid keys keep their defaults
+  static DatabaseTuning fromSettings(const QString& path);
+  // Read from the sqlite.ini beside the database file at dbPath
+  static DatabaseTuning forDatabase(const QString& dbPath);
+
+  // Settings SQLite keeps per connection, so each new one needs them
+  QStringList connectionPragmas() const;
+  // The above plus journal_mode, which is stored in the database file
+  QStringList pragmas() const;
+};
+
+#endif  // DATABASETUNING_H
@@ -0,0 +1,41 @@
+#include "databaseworker.h"
+
+namespace {
+// Journaled game results reach SQLite at most this late
+const int kJournalFlushMs = 5000;
+}  // namespace
+
+DatabaseWorker::DatabaseWorker(QObject* parent)
+    : QObject(parent),
+      executor(new QObject()),
+      flushTimer(nullptr),
+      userManager(nullptr) {
+  thread.setObjectName("DatabaseWorker");
+  executor->moveToThread(&thread);
+  thread.start();
+
+  // The connection must be opened on the thread that will use it
+  QMetaObject::invokeMethod(executor, [this]() {
+    userManager = new UserManager();
+    flushTimer = new QTimer();
+    connect(flushTimer, &QTimer::timeout, executor,
+            [this]() { userManager->flushJournal(); });
+    flushTimer->start(kJournalFlushMs);
+  });
+}
+
+DatabaseWorker::~DatabaseWorker() {
+  // Queued behind any pending saves, so they still reach the disk
+  QMetaObject::invokeMethod(executor, [this]() {
+    delete flushTimer;
+    delete userManager;
+    userManager = nullptr;
+    thread.quit();
+  });
+  thread.wait();
+  delete executor;
+}
+
+void DatabaseWorker::flush() {
+  QMetaObject::invokeMethod(executor, []() {}, Qt::BlockingQueuedConnection);
+}
@@ -0,0 +1,53 @@
+#ifndef DATABASEWORKER_H
+#define DATABASEWORKER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+
+#include "usermanager.h"
+
+// Owns the UserManager and its SQLite connection on a thread of their own
+// so the GUI never waits on the disk. Jobs run one at a time in the order
+// they were posted; a batch begun by one job stays open for the next.
+class DatabaseWorker : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit DatabaseWorker(QObject* parent = nullptr);
+  // Runs every job already posted, then closes the database
+  ~DatabaseWorker();
+
+  // Runs job(UserManager&) on the database thread
+  template <typename Job>
+  void post(Job job) {
+    QMetaObject::invokeMethod(executor,
+                              [this, job]() mutable { job(*userManager); });
+  }
+
+  // Runs job(UserManager&) on the database thread, then done(result) on
+  // the worker's own thread unless context has been destroyed by then
+  template <typename Job, typename Done>
+  void post(Job job, QObject* context, Done done) {
+    QPointer<QObject> receiver(context);
+    QMetaObject::invokeMethod(executor, [this, job, receiver,
+                                         done]() mutable {
+      auto result = job(*userManager);
+      QMetaObject::invokeMethod(this, [receiver, done, result]() mutable {
+        if (receiver) done(result);
+      });
+    });
+  }
+
+  // Blocks until every job posted so far has run
+  void flush();
+
+ private:
+  QThread thread;
+  QObject* executor;  // lives on thread; jobs are queued to it
+  QTimer* flushTimer;  // on thread, writes the result journal to SQLite
+  UserManager* userManager;
+};
+
+#endif  // DATABASEWORKER_H
@@ -0,0 +1,139 @@
+#include "evaluator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+namespace {
+const int kLines[8][3] = {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {0, 3, 6},
+                          {1, 4, 7}, {2, 5, 8}, {0, 4, 8}, {2, 4, 6}};
+
+std::atomic<uint64_t> nextSalt(1);
+
+int clampScore(int64_t score) {
+  return int(std::max<int64_t>(-Evaluator::kMaxScore,
+                               std::min<int64_t>(Evaluator::kMaxScore, score)));
+}
+}  // namespace
+
+Evaluator::Evaluator() { renewTableSalt(); }
+
+void Evaluator::renewTableSalt() {
+  // Mixed process-wide counter. The step differs from the golden-ratio
+  // splitmix64 stream the Zobrist keys come from; with the same stream a
+  // salt equals a Zobrist key, and two evaluators' keys alias positions.
+  uint64_t z = nextSalt.fetch_add(1, std::memory_order_relaxed) *
+               0xD6E8FEB86659FD93ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  salt = z ^ (z >> 31);
+}
+
+void LineEvaluator::evaluateBatch(const EvalPosition* positions, int count,
+                                  int* scores) {
+  for (int p = 0; p < count; ++p) {
+    const int8_t* cells = positions[p].cells;
+    int score = 0;
+    for (const auto& line : kLines) {
+      int own = 0;
+      int other = 0;
+      for (int cell : line) {
+        own += cells[cell] > 0;
+        other += cells[cell] < 0;
+      }
+      if (other == 0) score += own * own;
+      if (own == 0) score -= other * other;
+    }
+    scores[p] = score;
+  }
+}
+
+bool NetworkEvaluator::loadFromFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) return false;
+
+  // Strip comments, then read whitespace-separated tokens
+  std::stringstream content;
+  std::string line;
+  while (std::getline(file, line))
+    if (line.empty() || line[0] != '#') content << line << '\n';
+
+  std::string key;
+  int newHidden = 0;
+  int newShift = 0;
+  if (!(content >> key >> newHidden) || key != "hidden" || newHidden < 0 ||
+      newHidden > kMaxHidden)
+    return false;
+  if (!(content >> key >> newShift) || key != "shift" || newShift < 0 ||
+      newShift > 24)
+    return false;
+
+  auto readInts = [&content](std::vector<int32_t>& values, size_t n) {
+    values.resize(n);
+    for (int32_t& value : values)
+      if (!(content >> value)) return false;
+    return true;
+  };
+
+  std::vector<int32_t> w1;
+  std::vector<int32_t> b1;
+  std::vector<int32_t> w2;
+  int32_t b2 = 0;
+  if (!readInts(w1, size_t(kInputs) * newHidden) ||
+      !readInts(b1, size_t(newHidden)) ||
+      !readInts(w2, size_t(newHidden > 0 ? newHidden : kInputs)) ||
+      !(content >> b2))
+    return false;
+
+  hidden = newHidden;
+  shift = newShift;
+  inputWeights.swap(w1);
+  hiddenBias.swap(b1);
+  outputWeights.swap(w2);
+  outputBias = b2;
+  loaded = true;
+  renewTableSalt();
+  return true;
+}
+
+void NetworkEvaluator::evaluateBatch(const EvalPosition* positions, int count,
+                                     int* scores) {
+  if (!loaded) {
+    std::fill(scores, scores + count, 0);
+    return;
+  }
+
+  if (hidden == 0) {
+    for (int p = 0; p < count; ++p) {
+      int64_t sum = outputBias;
+      for (int cell = 0; cell < 9; ++cell) {
+        int8_t value = positions[p].cells[cell];
+        if (value > 0) sum += outputWeights[cell];
+        if (value < 0) sum += outputWeights[9 + cell];
+      }
+      scores[p] = clampScore(sum >> shift);
+    }
+    return;
+  }
+
+  // Inputs are one-hot, so the first layer is a sum of weight rows. The
+  // inner loops run over contiguous hidden units and auto-vectorise. The
+  // accumulator lives on the stack: no allocation per batch.
+  int32_t acc[kMaxHidden];
+  for (int p = 0; p < count; ++p) {
+    std::copy(hiddenBias.begin(), hiddenBias.end(), acc);
+    for (int cell = 0; cell < 9; ++cell) {
+      int8_t value = positions[p].cells[cell];
+      if (value == 0) continue;
+      const int32_t* row =
+          &inputWeights[size_t(value > 0 ? cell : 9 + cell) * hidden];
+      for (int h = 0; h < hidden; ++h) acc[h] += row[h];
+    }
+
+    int64_t sum = 0;
+    for (int h = 0; h < hidden; ++h)
+      sum += int64_t(std::max(acc[h] >> shift, 0)) * outputWeights[h];
+    scores[p] = clampScore((sum + outputBias) >> shift);
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A 3x3 position seen from the side to move: +1 own stone, -1 opponent
+// stone, 0 empty, cells row-major
+struct EvalPosition {
+  int8_t cells[9];
+};
+
+// Static evaluation of non-terminal search leaves. The search hands over
+// every leaf below a frontier node in one call, so implementations can
+// amortise per-call cost across the batch. Scores are for the side to move
+// and must stay within [-kMaxScore, kMaxScore], well below any win score.
+class Evaluator {
+ public:
+  static const int kMaxScore = 100;
+
+  Evaluator();
+  virtual ~Evaluator() = default;
+  virtual void evaluateBatch(const EvalPosition* positions, int count,
+                             int* scores) = 0;
+
+  // Mixed into transposition table keys, so searches with different
+  // evaluators never reuse each other's scores from a shared table
+  uint64_t tableSalt() const { return salt; }
+
+ protected:
+  // Call whenever the evaluation function changes, e.g. on new weights
+  void renewTableSalt();
+
+ private:
+  uint64_t salt;
+};
+
+// Default evaluator: open lines weighted by the square of their occupancy
+class LineEvaluator : public Evaluator {
+ public:
+  void evaluateBatch(const EvalPosition* positions, int count,
+                     int* scores) override;
+};
+
+// Fixed-point network over 18 one-hot inputs (own stones, then opponent
+// stones). With hidden = 0 it is a linear model; otherwise one ReLU hidden
+// layer. Weights are integers scaled by 2^shift, read from a text file:
+//
+//   hidden <H>
+//   shift <S>
+//   <18 * H first-layer weights, feature-major> <H hidden biases>
+//   <H output weights, or 18 when H = 0> <output bias>
+//
+// Lines starting with '#' are comments. H is at most kMaxHidden.
+class NetworkEvaluator : public Evaluator {
+ public:
+  static constexpr int kMaxHidden = 256;
+
+  bool loadFromFile(const std::string& path);
+  bool isLoaded() const { return loaded; }
+  void evaluateBatch(const EvalPosition* positions, int count,
+                     int* scores) override;
+
+ private:
+  static const int kInputs = 18;
+
+  bool loaded = false;
+  int hidden = 0;
+  int shift = 0;
+  std::vector<int32_t> inputWeights;  // kInputs rows of `hidden` weights
+  std::vector<int32_t> hiddenBias;
+  std::vector<int32_t> outputWeights;
+  int32_t outputBias = 0;
+};
+#endif  // EVALUATOR_H
@@ -0,0 +1,127 @@
+#include "gameanalyzer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+#include <vector>
+
+#include "searchtask.h"
+#include "tictactoegame.h"
+
+namespace {
+const int kChunkSize = 16;
+
+int sign(int value) { return (value > 0) - (value < 0); }
+
+GameAnalysis analyzeMoves(TicTacToeGame& game, const QVector<GameMove>& moves) {
+  GameAnalysis analysis;
+  game.resetGame();
+  if (moves.isEmpty()) return analysis;
+
+  double credit = 0.0;
+  Player toMove = HUMAN;
+  for (const GameMove& move : moves) {
+    if (game.checkWin(HUMAN) || game.checkWin(AI) || game.isBoardFull() ||
+        move.player != toMove || move.row < 0 || move.row > 2 ||
+        move.col < 0 || move.col > 2 ||
+        game.getCell(move.row, move.col) != NONE)
+      return GameAnalysis();
+
+    // Exact scores for every legal move, best compared with played
+    SearchTask task(game, toMove, true);
+    task.step(LONG_MAX);
+    const std::vector<int>& cells = task.getRootMoves();
+    const std::vector<int>& scores = task.getRootScores();
+    int best = *std::max_element(scores.begin(), scores.end());
+    int played = best;
+    int cell = move.row * 3 + move.col;
+    for (size_t m = 0; m < cells.size(); ++m)
+      if (cells[m] == cell) played = scores[m];
+
+    MoveQuality quality = MOVE_BEST;
+    if (played < best)
+      quality = sign(played) < sign(best) ? MOVE_BLUNDER : MOVE_INACCURACY;
+    analysis.moves.append(quality);
+    credit += quality == MOVE_BEST ? 1.0 : quality == MOVE_INACCURACY ? 0.5 : 0;
+
+    game.makeMove(move.row, move.col, toMove);
+    toMove = (toMove == HUMAN) ? AI : HUMAN;
+  }
+
+  analysis.valid = true;
+  analysis.accuracy = 100.0 * credit / moves.size();
+  return analysis;
+}
+}  // namespace
+
+QString GameAnalysis::qualityString() const {
+  static const char kLetters[] = {'B', 'I', 'X'};
+  QString text;
+  text.reserve(moves.size());
+  for (MoveQuality quality : moves) text.append(QLatin1Char(kLetters[quality]));
+  return text;
+}
+
+QVector<MoveQuality> GameAnalysis::qualityFromString(const QString& text) {
+  QVector<MoveQuality> moves;
+  for (QChar letter : text) {
+    if (letter == QLatin1Char('I'))
+      moves.append(MOVE_INACCURACY);
+    else if (letter == QLatin1Char('X'))
+      moves.append(MOVE_BLUNDER);
+    else
+      moves.append(MOVE_BEST);
+  }
+  return moves;
+}
+
+GameAnalysis GameAnalyzer::analyze(const QVector<GameMove>& moves) {
+  TicTacToeGame game;
+  game.setTranspositionTable(&TranspositionTable::shared());
+  return analyzeMoves(game, moves);
+}
+
+GameAnalysis GameAnalyzer::analyze(const StoredGame& stored) {
+  QVector<GameMove> moves;
+  GameAnalysis analysis;
+  if (GameValidator::loadMoves(stored, moves))
+    analysis = analyze(moves);
+  analysis.gameId = stored.id;
+  return analysis;
+}
+
+QVector<GameAnalysis> GameAnalyzer::analyzeAll(const QVector<StoredGame>& games,
+                                               int threadCount) {
+  int threads = threadCount > 0
+                    ? threadCount
+                    : int(std::max(1u, std::thread::hardware_concurrency()));
+  threads = std::max(1, std::min(threads, int(games.size() / kChunkSize) + 1));
+
+  // Each worker writes only its own slots, so no locking is needed
+  QVector<GameAnalysis> results(games.size());
+  GameAnalysis* out = results.data();
+  std::atomic<int> nextChunk(0);
+
+  auto worker = [&]() {
+    TicTacToeGame game;
+    game.setTranspositionTable(&TranspositionTable::shared());
+    QVector<GameMove> moves;
+    while (true) {
+      int begin = nextChunk.fetch_add(1) * kChunkSize;
+      if (begin >= games.size()) break;
+      int end = std::min(int(games.size()), begin + kChunkSize);
+      for (int i = begin; i < end; ++i) {
+        if (GameValidator::loadMoves(games[i], moves))
+          out[i] = analyzeMoves(game, moves);
+        out[i].gameId = games[i].id;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; ++t) workers.emplace_back(worker);
+  worker();
+  for (std::thread& thread : workers) thread.join();
+  return results;
+}
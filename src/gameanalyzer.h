@@ -0,0 +1,40 @@
+#ifndef GAMEANALYZER_H
+#define GAMEANALYZER_H
+#include <QString>
+#include <QVector>
+
+#include "gamevalidator.h"
+#include "user.h"
+
+// How a move compares with the solver's best move in the same position
+enum MoveQuality {
+  MOVE_BEST = 0,     // keeps the best exact value
+  MOVE_INACCURACY,   // same outcome, but a slower win or faster loss
+  MOVE_BLUNDER       // throws away a win or a draw
+};
+
+struct GameAnalysis {
+  qint64 gameId = 0;
+  bool valid = false;  // false if the moves do not replay (see validator)
+  QVector<MoveQuality> moves;
+  double accuracy = 0.0;  // 0..100; inaccuracies count half
+
+  // Compact text form, one letter per move: B best, I inaccuracy, X blunder
+  QString qualityString() const;
+  static QVector<MoveQuality> qualityFromString(const QString& text);
+};
+
+// Post-game analysis: every move of a stored game is compared with the
+// exact values of all moves in its position, from one full-depth search
+// per ply. The shared transposition table makes repeated positions across
+// games nearly free, and games are spread over worker threads.
+class GameAnalyzer {
+ public:
+  static GameAnalysis analyze(const QVector<GameMove>& moves);
+  static GameAnalysis analyze(const StoredGame& game);
+
+  // Results are in the order of games; threadCount 0 = hardware concurrency
+  static QVector<GameAnalysis> analyzeAll(const QVector<StoredGame>& games,
+                                          int threadCount = 0);
+};
+#endif  // GAMEANALYZER_H
@@ -0,0 +1,83 @@
+#include "gamehistorymodel.h"
+
+#include <utility>
+
+GameHistoryModel::GameHistoryModel(DatabaseWorker* database, QObject* parent)
+    : QAbstractListModel(parent),
+      database(database),
+      exhausted(true),
+      fetching(false),
+      generation(0) {}
+
+void GameHistoryModel::setUsername(const QString& name) {
+  beginResetModel();
+  username = name;
+  records.clear();
+  cursor = HistoryCursor();
+  exhausted = username.isEmpty();
+  fetching = false;
+  ++generation;
+  endResetModel();
+}
+
+int GameHistoryModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : records.size();
+}
+
+QVariant GameHistoryModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid() || index.row() >= records.size()) return QVariant();
+
+  const GameRecord& game = records[index.row()];
+  if (role == Qt::UserRole) return game.id;
+  if (role != Qt::DisplayRole) return QVariant();
+
+  QString resultEmoji = (game.result == "Won")    ? "🏆"
+                        : (game.result == "Lost") ? "😞"
+                                                  : "🤝";
+  return QString("%1 Game %2 - vs %3 (%4)\n📅 %5")
+      .arg(resultEmoji)
+      .arg(index.row() + 1)
+      .arg(game.opponent)
+      .arg(game.result)
+      .arg(game.timestamp.toString("MMM dd, hh:mm"));
+}
+
+bool GameHistoryModel::canFetchMore(const QModelIndex& parent) const {
+  return !parent.isValid() && !exhausted && !fetching;
+}
+
+void GameHistoryModel::fetchMore(const QModelIndex& parent) {
+  if (!canFetchMore(parent)) return;
+
+  fetching = true;
+  QString name = username;
+  HistoryCursor from = cursor;
+  int requested = generation;
+  database->post(
+      [name, from](UserManager& users) mutable {
+        QList<GameRecord> page =
+            users.loadGameHistoryPage(name, from, kPageSize);
+        return std::make_pair(page, from);
+      },
+      this,
+      [this, requested](
+          const std::pair<QList<GameRecord>, HistoryCursor>& result) {
+        appendPage(requested, result.first, result.second);
+      });
+}
+
+void GameHistoryModel::appendPage(int requested,
+                                  const QList<GameRecord>& page,
+                                  const HistoryCursor& next) {
+  if (requested != generation) return;
+
+  fetching = false;
+  cursor = next;
+  if (page.size() < kPageSize) exhausted = true;
+  if (page.isEmpty()) return;
+
+  beginInsertRows(QModelIndex(), records.size(),
+                  records.size() + page.size() - 1);
+  records.append(page);
+  endInsertRows();
+}
@@ -0,0 +1,46 @@
+#ifndef GAMEHISTORYMODEL_H
+#define GAMEHISTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+
+#include "databaseworker.h"
+
+// One user's game history, newest first, fetched from the database a page
+// at a time as the view scrolls. Pages load on the database thread and
+// arrive asynchronously. Rows carry no move data; load it with
+// UserManager::loadGameMoves when a game is opened.
+class GameHistoryModel : public QAbstractListModel {
+  Q_OBJECT
+
+ public:
+  static const int kPageSize = 50;
+
+  explicit GameHistoryModel(DatabaseWorker* database,
+                            QObject* parent = nullptr);
+
+  // Drops the loaded rows and starts again from the user's newest game
+  void setUsername(const QString& username);
+  const GameRecord& record(int row) const { return records[row]; }
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+
+ private:
+  void appendPage(int requested, const QList<GameRecord>& page,
+                  const HistoryCursor& next);
+
+  DatabaseWorker* database;
+  QString username;
+  QList<GameRecord> records;
+  HistoryCursor cursor;
+  bool exhausted;
+  bool fetching;
+  int generation;  // bumped on reset so late pages are dropped
+};
+
+#endif  // GAMEHISTORYMODEL_H
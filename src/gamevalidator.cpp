@@ -0,0 +1,148 @@
+#include "gamevalidator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tictactoegame.h"
+
+namespace {
+// Games claimed per atomic increment; small enough to balance the tail
+const int kChunkSize = 256;
+
+GameCheck replay(TicTacToeGame& game, const QVector<GameMove>& moves,
+                 const QString& result, const QString& playerSymbol,
+                 int* moveIndex) {
+  game.resetGame();
+  if (moveIndex) *moveIndex = -1;
+
+  Player toMove = HUMAN;
+  for (int i = 0; i < moves.size(); ++i) {
+    const GameMove& move = moves[i];
+    if (moveIndex) *moveIndex = i;
+    if (game.checkWin(HUMAN) || game.checkWin(AI) || game.isBoardFull())
+      return GAME_MOVE_AFTER_END;
+    if (move.player != toMove ||
+        !game.makeMove(move.row, move.col, static_cast<Player>(move.player)))
+      return GAME_ILLEGAL_MOVE;
+    toMove = (toMove == HUMAN) ? AI : HUMAN;
+  }
+  if (moveIndex) *moveIndex = -1;
+
+  if (playerSymbol != "X" && playerSymbol != "O") return GAME_RESULT_MISMATCH;
+  Player self = (playerSymbol == "X") ? HUMAN : AI;
+  Player other = (self == HUMAN) ? AI : HUMAN;
+  bool matches = false;
+  if (result == "Won")
+    matches = game.checkWin(self);
+  else if (result == "Lost")
+    matches = game.checkWin(other);
+  else if (result == "Tie")
+    matches = game.isBoardFull() && !game.checkWin(HUMAN) &&
+              !game.checkWin(AI);
+  return matches ? GAME_OK : GAME_RESULT_MISMATCH;
+}
+
+GameCheck check(TicTacToeGame& game, const StoredGame& stored,
+                QVector<GameMove>& moves, int* moveIndex) {
+  if (moveIndex) *moveIndex = -1;
+  if (!GameValidator::loadMoves(stored, moves)) return GAME_MALFORMED;
+  if (moves.isEmpty()) return GAME_NO_MOVES;
+  return replay(game, moves, stored.result, stored.playerSymbol, moveIndex);
+}
+}  // namespace
+
+bool GameValidator::parseMoves(const QString& text, QVector<GameMove>& moves) {
+  // Hand-rolled instead of split(): no temporary strings per move, and
+  // anything but "int,int,int" separated by ';' is rejected
+  moves.clear();
+  const QChar* p = text.constData();
+  const QChar* end = p + text.size();
+  while (p < end) {
+    int fields[3];
+    for (int f = 0; f < 3; ++f) {
+      bool negative = p < end && *p == QLatin1Char('-');
+      if (negative) ++p;
+      if (p == end || !p->isDigit()) return false;
+      int value = 0;
+      while (p < end && p->isDigit() && value < 100000)
+        value = value * 10 + p++->digitValue();
+      fields[f] = negative ? -value : value;
+      QChar separator = (f < 2) ? QLatin1Char(',') : QLatin1Char(';');
+      if (p < end && *p == separator)
+        ++p;
+      else if (f < 2 || p < end)
+        return false;
+    }
+    moves.append(GameMove(fields[0], fields[1], fields[2]));
+  }
+  return true;
+}
+
+bool GameValidator::loadMoves(const StoredGame& game,
+                              QVector<GameMove>& moves) {
+  if (!game.movesBlob.isEmpty()) return decodeMoves(game.movesBlob, moves);
+  return parseMoves(game.movesData, moves);
+}
+
+GameCheck GameValidator::validate(const QVector<GameMove>& moves,
+                                  const QString& result,
+                                  const QString& playerSymbol, int* moveIndex) {
+  TicTacToeGame game;
+  return replay(game, moves, result, playerSymbol, moveIndex);
+}
+
+GameCheck GameValidator::validate(const StoredGame& game, int* moveIndex) {
+  TicTacToeGame board;
+  QVector<GameMove> moves;
+  return check(board, game, moves, moveIndex);
+}
+
+ValidationReport GameValidator::validateAll(const QVector<StoredGame>& games,
+                                            int threadCount) {
+  int threads = threadCount > 0
+                    ? threadCount
+                    : int(std::max(1u, std::thread::hardware_concurrency()));
+  threads = std::max(1, std::min(threads, int(games.size() / kChunkSize) + 1));
+
+  ValidationReport report;
+  std::mutex reportMutex;
+  std::atomic<int> nextChunk(0);
+
+  auto worker = [&]() {
+    // One board and move buffer per thread, reused for every game
+    TicTacToeGame game;
+    QVector<GameMove> moves;
+    int counts[GAME_CHECK_COUNT] = {};
+    QVector<GameIssue> issues;
+
+    while (true) {
+      int begin = nextChunk.fetch_add(1) * kChunkSize;
+      if (begin >= games.size()) break;
+      int end = std::min(int(games.size()), begin + kChunkSize);
+      for (int i = begin; i < end; ++i) {
+        int moveIndex = -1;
+        GameCheck result = check(game, games[i], moves, &moveIndex);
+        ++counts[result];
+        if (result != GAME_OK && result != GAME_NO_MOVES)
+          issues.append({games[i].id, games[i].username, result, moveIndex});
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(reportMutex);
+    for (int c = 0; c < GAME_CHECK_COUNT; ++c) report.counts[c] += counts[c];
+    report.issues += issues;
+  };
+
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads; ++t) workers.emplace_back(worker);
+  worker();
+  for (std::thread& thread : workers) thread.join();
+
+  report.gamesChecked = games.size();
+  std::sort(report.issues.begin(), report.issues.end(),
+            [](const GameIssue& a, const GameIssue& b) { return a.id < b.id; });
+  return report;
+}
@@ -0,0 +1,61 @@
+#ifndef GAMEVALIDATOR_H
+#define GAMEVALIDATOR_H
+#include <QString>
+#include <QVector>
+
+#include "user.h"
+
+// Outcome of replaying one stored game, in order of precedence
+enum GameCheck {
+  GAME_OK = 0,
+  GAME_NO_MOVES,         // recorded before move storage; nothing to check
+  GAME_MALFORMED,        // stored moves do not decode
+  GAME_ILLEGAL_MOVE,     // off the board, occupied cell or wrong turn
+  GAME_MOVE_AFTER_END,   // a move follows a win or a full board
+  GAME_RESULT_MISMATCH,  // final position disagrees with result/symbol
+  GAME_CHECK_COUNT
+};
+
+// One stored game as read from game_history
+struct StoredGame {
+  qint64 id = 0;
+  QString username;
+  QString result;        // "Won", "Lost" or "Tie" for playerSymbol
+  QString playerSymbol;  // "X" or "O"
+  QByteArray movesBlob;  // encodeMoves() form; used when present
+  QString movesData;     // legacy "row,col,player;..." text
+};
+
+struct GameIssue {
+  qint64 id;
+  QString username;
+  GameCheck check;
+  int moveIndex;  // offending move, or -1 for the whole game
+};
+
+struct ValidationReport {
+  int gamesChecked = 0;
+  int counts[GAME_CHECK_COUNT] = {};
+  QVector<GameIssue> issues;  // every game that is not OK or NO_MOVES, by id
+};
+
+// Replays recorded games through TicTacToeGame to find corrupt history.
+// X always moves first and players alternate; a finished game must end on
+// the move that decided it and match its recorded result.
+class GameValidator {
+ public:
+  // Strict parse of moves_data; false if any entry is not three integers
+  static bool parseMoves(const QString& text, QVector<GameMove>& moves);
+  // Decodes whichever form the game was stored in
+  static bool loadMoves(const StoredGame& game, QVector<GameMove>& moves);
+
+  static GameCheck validate(const QVector<GameMove>& moves,
+                            const QString& result, const QString& playerSymbol,
+                            int* moveIndex = nullptr);
+  static GameCheck validate(const StoredGame& game, int* moveIndex = nullptr);
+
+  // Checks all games on threadCount threads (0 = hardware concurrency)
+  static ValidationReport validateAll(const QVector<StoredGame>& games,
+                                      int threadCount = 0);
+};
+#endif  // GAMEVALIDATOR_H
@@ -1,5 +1,24 @@
 #include "mainwindow.h"
 
+namespace {
+enum RegisterOutcome { REGISTER_OK, REGISTER_NAME_TAKEN, REGISTER_FAILED };
+
+// History block text; the won-lost-tied record against the opponent is
+// added once the statistics arrive
+QString historyDetails(const GameRecord& record, const StatLine* versus) {
+  QString opponent = versus ? QString("vs %1 (%2-%3-%4)")
+                                  .arg(record.opponent)
+                                  .arg(versus->won)
+                                  .arg(versus->lost)
+                                  .arg(versus->tied)
+                            : QString("vs %1").arg(record.opponent);
+  return QString("%1\n%2\n%3")
+      .arg(opponent)
+      .arg(record.gameMode)
+      .arg(record.timestamp.toString("MMM dd"));
+}
+}  // namespace
+
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent),
       isPlayerX(true),
@@ -12,11 +31,15 @@ MainWindow::MainWindow(QWidget* parent)
       currentReplayMoveIndex(0),
       isReplaying(false) {
   game = new TicTacToeGame();
-  userManager = new UserManager();
+  database = new DatabaseWorker(this);
+  currentUser = nullptr;
 
   aiTimer = new QTimer(this);
   aiTimer->setSingleShot(true);
   connect(aiTimer, &QTimer::timeout, this, &MainWindow::makeAIMove);
+  searchTimer = new QTimer(this);
+  connect(searchTimer, &QTimer::timeout, this, &MainWindow::continueAISearch);
+  aiSearch = nullptr;
 
   // Initialize animations
   celebrationAnimation = new QPropertyAnimation(this);
@@ -35,8 +58,9 @@ MainWindow::MainWindow(QWidget* parent)
 }
 
 MainWindow::~MainWindow() {
+  delete aiSearch;
   delete game;
-  delete userManager;
+  delete currentUser;
 }
 
 void MainWindow::setupUI() {
@@ -948,7 +972,7 @@ void MainWindow::setupPlayerNamesUI() {
 }
 
 void MainWindow::updateGameHistoryDisplay() {
-  User* user = userManager->getCurrentUser();
+  User* user = currentUser;
   if (!user) return;
 
   QList<GameRecord> history = user->getGameHistory();
@@ -979,12 +1003,7 @@ void MainWindow::updateGameHistoryDisplay() {
                   "}")
               .arg(resultColor));
 
-      QString details = QString("vs %1\n%2\n%3")
-                            .arg(record.opponent)
-                            .arg(record.gameMode)
-                            .arg(record.timestamp.toString("MMM dd"));
-
-      gameDetailLabels[i]->setText(details);
+      gameDetailLabels[i]->setText(historyDetails(record, nullptr));
     } else {
       // Empty game slot
       gameResultLabels[i]->setText("No Game");
@@ -997,6 +1016,22 @@ void MainWindow::updateGameHistoryDisplay() {
       gameDetailLabels[i]->setText("---");
     }
   }
+
+  // Per-opponent records are single lookups in the aggregate tables
+  QString username = user->getUsername();
+  database->post(
+      [username](UserManager& users) {
+        return users.loadStatistics(username);
+      },
+      this,
+      [this, username, history](const UserStatistics& statistics) {
+        if (!currentUser || currentUser->getUsername() != username) return;
+        for (int i = 0; i < 5 && i < history.size(); ++i) {
+          StatLine versus = UserStatistics::find(statistics.byOpponent,
+                                                 history[i].opponent);
+          gameDetailLabels[i]->setText(historyDetails(history[i], &versus));
+        }
+      });
 }
 void MainWindow::setupGameUI() {
   gameWidget = new QWidget();
@@ -1147,6 +1182,32 @@ void MainWindow::setupGameUI() {
   connect(backToSetupBtn, &QPushButton::clicked, this,
           &MainWindow::startGameSetup);
 
+  QString takebackStyle =
+      "QPushButton {"
+      "font-size: 20px; font-weight: bold; padding: 15px 25px;"
+      "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
+      "stop:0 #667eea, stop:1 #764ba2);"
+      "color: white; border: none; border-radius: 12px;"
+      "}"
+      "QPushButton:hover {"
+      "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
+      "stop:0 #5a6fd8, stop:1 #6a4190);"
+      "transform: translateY(-2px);"
+      "}"
+      "QPushButton:disabled { background: rgba(100, 100, 120, 0.5); }";
+
+  undoBtn = new QPushButton("↩️ UNDO");
+  undoBtn->setStyleSheet(takebackStyle);
+  undoBtn->setEnabled(false);
+  connect(undoBtn, &QPushButton::clicked, this, &MainWindow::onUndoClicked);
+
+  redoBtn = new QPushButton("↪️ REDO");
+  redoBtn->setStyleSheet(takebackStyle);
+  redoBtn->setEnabled(false);
+  connect(redoBtn, &QPushButton::clicked, this, &MainWindow::onRedoClicked);
+
+  controlLayout->addWidget(undoBtn);
+  controlLayout->addWidget(redoBtn);
   controlLayout->addWidget(newGameBtn);
   controlLayout->addWidget(backToSetupBtn);
 
@@ -1408,7 +1469,7 @@ void MainWindow::setupUserProfileUI() {
   userStatsLabel = new QLabel("📊 Your Gaming Statistics");
   userStatsLabel->setAlignment(Qt::AlignCenter);  // CENTERED
   userStatsLabel->setWordWrap(true);
-  userStatsLabel->setFixedHeight(220);
+  userStatsLabel->setFixedHeight(260);
   userStatsLabel->setStyleSheet(
       "QLabel {"
       "font-size: 16px; color: #ffffff;"
@@ -1763,23 +1824,25 @@ void MainWindow::setupGameReplayUI() {
       "QLabel { font-size: 16px; font-weight: bold; color: #ffffff; margin: "
       "5px; }");
 
-  gameListWidget = new QListWidget();
-  gameListWidget->setFixedHeight(150);
-  gameListWidget->setStyleSheet(
-      "QListWidget {"
+  historyModel = new GameHistoryModel(database, this);
+  gameListView = new QListView();
+  gameListView->setModel(historyModel);
+  gameListView->setFixedHeight(150);
+  gameListView->setStyleSheet(
+      "QListView {"
       "background: rgba(30, 35, 55, 0.7);"
       "border: 2px solid rgba(0, 255, 255, 0.4);"
       "border-radius: 10px; color: #ffffff;"
       "font-size: 13px; padding: 8px;"
       "}"
-      "QListWidget::item {"
+      "QListView::item {"
       "padding: 6px; border-radius: 5px; margin: 1px;"
       "}"
-      "QListWidget::item:selected {"
+      "QListView::item:selected {"
       "background: rgba(0, 255, 255, 0.4);"
       "}");
 
-  connect(gameListWidget, &QListWidget::itemClicked, this,
+  connect(gameListView, &QListView::clicked, this,
           &MainWindow::onGameSelected);
 
   // Replay controls
@@ -1883,7 +1946,7 @@ void MainWindow::setupGameReplayUI() {
 
   // Add all left panel components
   leftPanelLayout->addWidget(gameListLabel);
-  leftPanelLayout->addWidget(gameListWidget);
+  leftPanelLayout->addWidget(gameListView);
   leftPanelLayout->addWidget(controlsLabel);
   leftPanelLayout->addLayout(controlsLayout);
   leftPanelLayout->addWidget(speedLabel);
@@ -2416,7 +2479,7 @@ void MainWindow::showRegisterScreen() {
 }
 
 void MainWindow::showUserProfile() {
-  if (!userManager->isUserLoggedIn()) {
+  if (!currentUser) {
     showLoginScreen();
     return;
   }
@@ -2426,7 +2489,7 @@ void MainWindow::showUserProfile() {
 }
 
 void MainWindow::updateUserProfileDisplay() {
-  User* user = userManager->getCurrentUser();
+  User* user = currentUser;
   if (!user) return;
 
   userWelcomeLabel->setText(
@@ -2450,6 +2513,27 @@ void MainWindow::updateUserProfileDisplay() {
           .arg(user->getLastLogin().toString("MMM dd, yyyy hh:mm AP"));
 
   userStatsLabel->setText(stats);
+
+  // Streaks come from the aggregate tables, never from the raw history
+  QString username = user->getUsername();
+  database->post(
+      [username](UserManager& users) {
+        return users.loadStatistics(username);
+      },
+      this,
+      [this, username, stats](const UserStatistics& statistics) {
+        if (!currentUser || currentUser->getUsername() != username) return;
+        if (statistics.streakLength == 0) return;
+        QString kind = (statistics.streakResult == "Won")    ? "Win"
+                       : (statistics.streakResult == "Lost") ? "Loss"
+                                                             : "Tie";
+        userStatsLabel->setText(
+            stats + QString(" 🔥 Current Streak: %1 × %2\n "
+                            "🏅 Best Win Streak: %3\n")
+                        .arg(statistics.streakLength)
+                        .arg(kind)
+                        .arg(statistics.bestWinStreak));
+      });
 }
 
 void MainWindow::onLoginClicked() {
@@ -2467,26 +2551,43 @@ void MainWindow::onLoginClicked() {
     return;
   }
 
-  if (userManager->loginUser(username, password)) {
-    // With this:
-    QMessageBox msgBox;
-    msgBox.setWindowTitle("✅ Welcome Back!");
-    msgBox.setText(QString("Hello %1! Ready to play? 🎮").arg(username));
-    msgBox.setIcon(QMessageBox::Information);
-    msgBox.setStyleSheet("background-color: white; color: black;");
-    msgBox.exec();
-    showUserProfile();
-  } else {
-    // With this:
-    QMessageBox msgBox;
-    msgBox.setWindowTitle("❌ Login Failed");
-    msgBox.setText("Invalid username or password. Please try again! 🔐");
-    msgBox.setIcon(QMessageBox::Warning);
-    msgBox.setStyleSheet("background-color: white; color: black;");
-    msgBox.exec();
-    loginPasswordEdit->clear();
-    loginPasswordEdit->setFocus();
-  }
+  // Checked on the database thread; the reply arrives as a copy of the
+  // user, with no name if the login failed
+  loginBtn->setEnabled(false);
+  database->post(
+      [username, password](UserManager& users) {
+        return users.loginUser(username, password) ? *users.getCurrentUser()
+                                                   : User();
+      },
+      this,
+      [this, username](const User& user) {
+        loginBtn->setEnabled(true);
+        if (!user.getUsername().isEmpty()) {
+          delete currentUser;
+          currentUser = new User(user);
+          // Catch up on games played since the last analysis
+          database->post(
+              [](UserManager& users) { users.analyzeGameHistory(); });
+          QMessageBox msgBox;
+          msgBox.setWindowTitle("✅ Welcome Back!");
+          msgBox.setText(
+              QString("Hello %1! Ready to play? 🎮").arg(username));
+          msgBox.setIcon(QMessageBox::Information);
+          msgBox.setStyleSheet("background-color: white; color: black;");
+          msgBox.exec();
+          showUserProfile();
+        } else {
+          QMessageBox msgBox;
+          msgBox.setWindowTitle("❌ Login Failed");
+          msgBox.setText(
+              "Invalid username or password. Please try again! 🔐");
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.setStyleSheet("background-color: white; color: black;");
+          msgBox.exec();
+          loginPasswordEdit->clear();
+          loginPasswordEdit->setFocus();
+        }
+      });
 }
 
 void MainWindow::onRegisterClicked() {
@@ -2527,47 +2628,54 @@ void MainWindow::onRegisterClicked() {
     return;
   }
 
-  if (userManager->userExists(username)) {
-    // Replace username exists warning:
-    QMessageBox msgBox;
-    msgBox.setWindowTitle("❌ Registration Failed");
-    msgBox.setText("Username already exists. Please choose another! 👤");
-    msgBox.setIcon(QMessageBox::Warning);
-    msgBox.setStyleSheet("background-color: white; color: black;");
-    msgBox.exec();
-    registerUsernameEdit->setFocus();
-    return;
-  }
-
-  if (userManager->registerUser(username, password, email)) {
-    QMessageBox msgBox;
-    msgBox.setWindowTitle("🎉 Registration Successful!");
-    msgBox.setText(QString("Welcome to Tic Tac Toe, %1! Your account has been "
-                           "created. Please sign in to start playing! 🎮")
-                       .arg(username));
-    msgBox.setIcon(QMessageBox::Information);
-    msgBox.setStyleSheet("background-color: white; color: black;");
-    msgBox.exec();
-    // Pre-fill login form
-    loginUsernameEdit->setText(username);
-    loginPasswordEdit->clear();
-    showLoginScreen();
-    loginPasswordEdit->setFocus();
-  } else {
-    // Replace registration failed message:
-    QMessageBox msgBox;
-    msgBox.setWindowTitle("❌ Registration Failed");
-    msgBox.setText("Failed to create account. Please try again! 🔄");
-    msgBox.setIcon(QMessageBox::Warning);
-    msgBox.setStyleSheet("background-color: white; color: black;");
-    msgBox.exec();
-  }
+  registerBtn->setEnabled(false);
+  database->post(
+      [username, password, email](UserManager& users) {
+        if (users.userExists(username)) return REGISTER_NAME_TAKEN;
+        return users.registerUser(username, password, email)
+                   ? REGISTER_OK
+                   : REGISTER_FAILED;
+      },
+      this,
+      [this, username](RegisterOutcome outcome) {
+        registerBtn->setEnabled(true);
+        QMessageBox msgBox;
+        msgBox.setStyleSheet("background-color: white; color: black;");
+        if (outcome == REGISTER_OK) {
+          msgBox.setWindowTitle("🎉 Registration Successful!");
+          msgBox.setText(
+              QString("Welcome to Tic Tac Toe, %1! Your account has been "
+                      "created. Please sign in to start playing! 🎮")
+                  .arg(username));
+          msgBox.setIcon(QMessageBox::Information);
+          msgBox.exec();
+          // Pre-fill login form
+          loginUsernameEdit->setText(username);
+          loginPasswordEdit->clear();
+          showLoginScreen();
+          loginPasswordEdit->setFocus();
+        } else if (outcome == REGISTER_NAME_TAKEN) {
+          msgBox.setWindowTitle("❌ Registration Failed");
+          msgBox.setText(
+              "Username already exists. Please choose another! 👤");
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.exec();
+          registerUsernameEdit->setFocus();
+        } else {
+          msgBox.setWindowTitle("❌ Registration Failed");
+          msgBox.setText("Failed to create account. Please try again! 🔄");
+          msgBox.setIcon(QMessageBox::Warning);
+          msgBox.exec();
+        }
+      });
 }
 
 void MainWindow::onLogoutClicked() {
-  if (userManager->isUserLoggedIn()) {
-    QString username = userManager->getCurrentUser()->getUsername();
-    userManager->logoutUser();
+  if (currentUser) {
+    QString username = currentUser->getUsername();
+    delete currentUser;
+    currentUser = nullptr;
+    database->post([](UserManager& users) { users.logoutUser(); });
 
     QMessageBox msgBox;
     msgBox.setWindowTitle("👋 Goodbye!");
@@ -2581,18 +2689,22 @@ void MainWindow::onLogoutClicked() {
 }
 
 void MainWindow::updateUserStats(bool won, bool lost, bool tied) {
-  User* user = userManager->getCurrentUser();
+  User* user = currentUser;
   if (!user) return;
 
   if (won) user->addWin();
   if (lost) user->addLoss();
   if (tied) user->addTie();
 
-  userManager->saveUserData();
+  // The database thread keeps its own copy of the user in step; results
+  // are journaled there and reach SQLite in batches
+  database->post([won, lost, tied](UserManager& users) {
+    users.recordStats(won, lost, tied);
+  });
 }
 
 void MainWindow::showGameHistory() {
-  if (!userManager->isUserLoggedIn()) {
+  if (!currentUser) {
     showLoginScreen();
     return;
   }
@@ -2605,13 +2717,13 @@ void MainWindow::recordGameResult(const QString& result,
                                   const QString& opponent,
                                   const QString& gameMode,
                                   const QString& playerSymbol) {
-  User* user = userManager->getCurrentUser();
+  User* user = currentUser;
   if (!user) return;
 
   GameRecord record(opponent, result, gameMode, playerSymbol);
   record.moves = QVector<GameMove>::fromList(currentGameMoves);
   user->addGameToHistory(record);
-  userManager->saveUserData();
+  database->post([record](UserManager& users) { users.recordGame(record); });
 
   // Clear moves for next game
   currentGameMoves.clear();
@@ -2622,57 +2734,130 @@ void MainWindow::recordGameMove(int row, int col, int player) {
   currentGameMoves.append(move);
 }
 
+void MainWindow::syncRecordedMoves() {
+  // The engine's move stack is the source of truth after a takeback
+  currentGameMoves.clear();
+  for (int i = 0; i < game->getMoveCount(); ++i) {
+    const MoveRecord& move = game->getMove(i);
+    currentGameMoves.append(
+        GameMove(move.cell / 3, move.cell % 3, static_cast<int>(move.player)));
+  }
+}
+
+void MainWindow::updateUndoRedoButtons() {
+  bool gameOver =
+      game->checkWin(HUMAN) || game->checkWin(AI) || game->isBoardFull();
+
+  // Against the AI a takeback needs at least one human move to undo
+  bool hasHumanMove = isPvP && game->canUndo();
+  for (int i = 0; !hasHumanMove && i < game->getMoveCount(); ++i) {
+    if (game->getMove(i).player == humanPlayer) hasHumanMove = true;
+  }
+
+  undoBtn->setEnabled(!gameOver && hasHumanMove);
+  redoBtn->setEnabled(!gameOver && game->canRedo());
+}
+
+void MainWindow::onUndoClicked() {
+  cancelAISearch();
+
+  if (isPvP) {
+    game->undoMove();
+  } else {
+    // Take back the AI reply together with the human move before it
+    while (game->undoMove() && game->getCurrentPlayer() != humanPlayer) {
+    }
+  }
+
+  syncRecordedMoves();
+  updateBoard();
+  showTurnAfterTakeback();
+}
+
+void MainWindow::onRedoClicked() {
+  cancelAISearch();
+
+  if (isPvP) {
+    game->redoMove();
+  } else {
+    while (game->redoMove() && game->getCurrentPlayer() != humanPlayer) {
+    }
+  }
+
+  syncRecordedMoves();
+  updateBoard();
+  showTurnAfterTakeback();
+}
+
+void MainWindow::showTurnAfterTakeback() {
+  if (isPvP) {
+    bool xToMove = game->getCurrentPlayer() == HUMAN;
+    currentPlayerLabel->setText(
+        QString("Current Player: %1 (%2)")
+            .arg(xToMove ? player1Name : player2Name, xToMove ? "X" : "O"));
+    statusLabel->setText("Move taken back ↩️");
+    return;
+  }
+
+  if (game->getCurrentPlayer() == aiPlayer) {
+    // Redo stopped on the AI's turn: let it answer again
+    QString aiSymbol = (aiPlayer == HUMAN) ? "X" : "O";
+    currentPlayerLabel->setText(
+        QString("Current Player: AI (%1)").arg(aiSymbol));
+    statusLabel->setText("AI is thinking...");
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        cells[i][j]->setEnabled(false);
+      }
+    }
+    aiTimer->start(800);
+  } else {
+    QString humanSymbol = (humanPlayer == HUMAN) ? "X" : "O";
+    currentPlayerLabel->setText("Current Player: You (" + humanSymbol + ")");
+    statusLabel->setText("Move taken back ↩️ Your turn!");
+  }
+}
+
 void MainWindow::showGameReplay() {
-  if (!userManager->isUserLoggedIn()) {
+  if (!currentUser) {
     showLoginScreen();
     return;
   }
 
-  // Clear the current game list
-  gameListWidget->clear();
+  // Games finished this session get analyzed before any of them is opened
+  database->post([](UserManager& users) {
+    users.flushJournal();
+    users.analyzeGameHistory();
+  });
 
-  // Load ALL game history from database (not just last 5)
-  User* currentUser = userManager->getCurrentUser();
-  if (currentUser) {
-    QString username = currentUser->getUsername();
-    QList<GameRecord> allHistory =
-        userManager->loadAllGameHistoryFromDatabase(username);
-
-    // Populate the game list with all historical games
-    for (int i = 0; i < allHistory.size(); ++i) {
-      const GameRecord& record = allHistory[i];
-      QString resultEmoji = (record.result == "Won")    ? "🏆"
-                            : (record.result == "Lost") ? "😞"
-                                                        : "🤝";
-      QString itemText = QString("%1 Game %2 - vs %3 (%4)\n📅 %5")
-                             .arg(resultEmoji)
-                             .arg(i + 1)
-                             .arg(record.opponent)
-                             .arg(record.result)
-                             .arg(record.timestamp.toString("MMM dd, hh:mm"));
-
-      QListWidgetItem* item = new QListWidgetItem(itemText);
-      item->setData(Qt::UserRole, QVariant::fromValue(record));
-      gameListWidget->addItem(item);
-    }
-  }
+  // The view pulls further pages from the database as it scrolls
+  historyModel->setUsername(currentUser->getUsername());
 
   stackedWidget->setCurrentWidget(gameReplayWidget);
   setWindowTitle("🎬 Tic Tac Toe - Game Replay");
 }
 
 void MainWindow::onGameSelected() {
-  QListWidgetItem* item = gameListWidget->currentItem();
-  if (!item) return;
-
-  int gameIndex = item->data(Qt::UserRole).toInt();
-  User* user = userManager->getCurrentUser();
-  if (!user) return;
-
-  QList<GameRecord> history = user->getGameHistory();
-  if (gameIndex >= 0 && gameIndex < history.size()) {
-    initializeReplay(history[gameIndex]);
-  }
+  QModelIndex index = gameListView->currentIndex();
+  if (!index.isValid()) return;
+
+  // Moves and analysis are loaded only for the game being opened
+  GameRecord record = historyModel->record(index.row());
+  qint64 id = record.id;
+  database->post(
+      [id](UserManager& users) {
+        return qMakePair(users.loadGameMoves(id), users.loadGameAnalysis(id));
+      },
+      this,
+      [this, record](const auto& loaded) mutable {
+        record.moves = loaded.first;
+        initializeReplay(record);
+        const GameAnalysis& analysis = loaded.second;
+        if (analysis.valid)
+          replayInfoLabel->setText(
+              replayInfoLabel->text() +
+              QString(" | 🎯 Accuracy %1%").arg(qRound(analysis.accuracy)));
+      });
 }
 
 void MainWindow::initializeReplay(const GameRecord& record) {
@@ -2809,8 +2994,8 @@ void MainWindow::showPlayerNamesInput() {
   setWindowTitle("👥 Tic Tac Toe - Player Names");
 
   // Pre-fill player 1 with logged-in user's name
-  if (userManager->isUserLoggedIn()) {
-    player1NameEdit->setText(userManager->getCurrentUser()->getUsername());
+  if (currentUser) {
+    player1NameEdit->setText(currentUser->getUsername());
   } else {
     player1NameEdit->setText("Player 1");
   }
@@ -2864,7 +3049,7 @@ void MainWindow::animateButton(QPushButton* button) {
 }
 
 void MainWindow::showGameSetup() {
-  if (!userManager->isUserLoggedIn()) {
+  if (!currentUser) {
     showLoginScreen();
     return;
   }
@@ -3059,7 +3244,33 @@ void MainWindow::cellClicked() {
 }
 
 void MainWindow::makeAIMove() {
-  auto move = game->getAIMove();
+  // The task searches a snapshot, so the board may be redrawn meanwhile
+  cancelAISearch();
+  aiSearch = new SearchTask(*game, aiPlayer);
+  searchTimer->start(0);
+}
+
+void MainWindow::continueAISearch() {
+  const long kSliceNodes = 2000;  // well under a frame on slow hardware
+  if (!aiSearch) {
+    searchTimer->stop();
+    return;
+  }
+  if (!aiSearch->step(kSliceNodes)) return;
+
+  std::pair<int, int> move = aiSearch->getMove();
+  cancelAISearch();
+  applyAIMove(move);
+}
+
+void MainWindow::cancelAISearch() {
+  aiTimer->stop();
+  searchTimer->stop();
+  delete aiSearch;
+  aiSearch = nullptr;
+}
+
+void MainWindow::applyAIMove(std::pair<int, int> move) {
   if (move.first != -1 && move.second != -1) {
     // Record AI move for replay
     recordGameMove(move.first, move.second, static_cast<int>(aiPlayer));
@@ -3123,6 +3334,8 @@ void MainWindow::updateBoard() {
       cells[i][j]->setEnabled(cell == NONE);
     }
   }
+
+  updateUndoRedoButtons();
 }
 
 void MainWindow::checkGameEnd() {
@@ -3132,8 +3345,8 @@ void MainWindow::checkGameEnd() {
 
     if (isPvP) {
       winner = QString("%1 Won! Congratulations!").arg(player1Name);
-      if (userManager->isUserLoggedIn() &&
-          userManager->getCurrentUser()->getUsername() == player1Name) {
+      if (currentUser &&
+          currentUser->getUsername() == player1Name) {
         gameMode = "PvP";
         opponent = player2Name;
         result = "Won";
@@ -3197,8 +3410,8 @@ void MainWindow::checkGameEnd() {
 
     if (isPvP) {
       winner = QString("%1 Won! Congratulations!").arg(player2Name);
-      if (userManager->isUserLoggedIn() &&
-          userManager->getCurrentUser()->getUsername() == player2Name) {
+      if (currentUser &&
+          currentUser->getUsername() == player2Name) {
         gameMode = "PvP";
         opponent = player1Name;
         result = "Won";
@@ -3269,7 +3482,7 @@ void MainWindow::checkGameEnd() {
 
     updateUserStats(false, false, true);
 
-    if (!isPvP && userManager->isUserLoggedIn()) {
+    if (!isPvP && currentUser) {
       QString difficulty = (selectedDifficulty == 1)   ? "Easy"
                            : (selectedDifficulty == 2) ? "Medium"
                                                        : "Hard";
@@ -3293,6 +3506,7 @@ void MainWindow::resetBoard() {
   }
 }
 void MainWindow::newGame() {
+  cancelAISearch();
   game->resetGame();
   updateBoard();
   statusLabel->setText("🎉 Let's Play and Have Fun! 🎉");
@@ -11,7 +11,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
-#include <QListWidget>
+#include <QListView>
 #include <QMainWindow>
 #include <QMessageBox>
 #include <QParallelAnimationGroup>
@@ -28,6 +28,9 @@
 #include <QVBoxLayout>
 #include <QtMath>
 
+#include "databaseworker.h"
+#include "gamehistorymodel.h"
+#include "searchtask.h"
 #include "tictactoegame.h"
 #include "usermanager.h"
 
@@ -46,6 +49,9 @@ class MainWindow : public QMainWindow {
   void onDifficultySelected();
   void onSymbolSelected();
   void makeAIMove();
+  void continueAISearch();
+  void onUndoClicked();
+  void onRedoClicked();
 
   // Login/Register slots
   void showLoginScreen();
@@ -102,6 +108,11 @@ class MainWindow : public QMainWindow {
   void recordGameResult(const QString& result, const QString& opponent,
                         const QString& gameMode, const QString& playerSymbol);
   void recordGameMove(int row, int col, int player);
+  void syncRecordedMoves();
+  void updateUndoRedoButtons();
+  void showTurnAfterTakeback();
+  void applyAIMove(std::pair<int, int> move);
+  void cancelAISearch();
 
   //
   QTimer* animationTimer;
@@ -121,14 +132,23 @@ class MainWindow : public QMainWindow {
   void animateButton(QPushButton* button);
 
   TicTacToeGame* game;
-  UserManager* userManager;
+  DatabaseWorker* database;
+  // GUI-side copy of the signed-in user; the database thread owns the
+  // authoritative one and every change is posted to both
+  User* currentUser;
 
   QPushButton* cells[3][3];
   QPushButton* newGameBtn;
   QPushButton* backToSetupBtn;
+  QPushButton* undoBtn;
+  QPushButton* redoBtn;
   QLabel* statusLabel;
   QLabel* currentPlayerLabel;
   QTimer* aiTimer;
+  // The AI searches in small slices between events so the window stays
+  // responsive; searchTimer drives aiSearch until it finishes.
+  QTimer* searchTimer;
+  SearchTask* aiSearch;
 
   // Animation members
   QPropertyAnimation* celebrationAnimation;
@@ -181,7 +201,8 @@ class MainWindow : public QMainWindow {
 
   // Game replay widgets
   QWidget* gameReplayWidget;
-  QListWidget* gameListWidget;
+  QListView* gameListView;
+  GameHistoryModel* historyModel;
   QPushButton* replayCells[3][3];
   QPushButton* playBtn;
   QPushButton* pauseBtn;
@@ -0,0 +1,287 @@
+#include "qubicgame.h"
+
+#include <algorithm>
+
+namespace {
+const int kWinScore = 10000;
+const int kMateWindow = 100;  // scores beyond kWinScore - kMateWindow are wins
+const int kLineWeights[4] = {0, 1, 4, 32};
+const uint64_t kTableSalt = 0x7A3D5E1F92C4B608ULL;  // separates Qubic keys
+const uint64_t kSideKey = 0xA24BAED4963EE407ULL;
+
+inline int popcount(uint64_t bits) { return __builtin_popcountll(bits); }
+
+// Line masks, the lines through each cell and a static move order (cells on
+// more lines first), built once at startup
+struct QubicTables {
+  uint64_t lines[QubicGame::kLineCount];
+  uint8_t cellLines[QubicGame::kCells][7];
+  uint8_t cellLineCount[QubicGame::kCells];
+  uint8_t moveOrder[QubicGame::kCells];
+  uint64_t zobrist[QubicGame::kCells][2];
+
+  QubicTables() {
+    int count = 0;
+    for (int dl = -1; dl <= 1; ++dl) {
+      for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+          // Keep one of each pair of opposite directions
+          int key = dl * 9 + dr * 3 + dc;
+          if (key <= 0) continue;
+          for (int l = 0; l < 4; ++l) {
+            for (int r = 0; r < 4; ++r) {
+              for (int c = 0; c < 4; ++c) {
+                int el = l + 3 * dl, er = r + 3 * dr, ec = c + 3 * dc;
+                if (el < 0 || el > 3 || er < 0 || er > 3 || ec < 0 || ec > 3)
+                  continue;
+                uint64_t mask = 0;
+                for (int step = 0; step < 4; ++step)
+                  mask |= 1ULL << QubicGame::cellIndex(
+                              l + step * dl, r + step * dr, c + step * dc);
+                lines[count++] = mask;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for (int cell = 0; cell < QubicGame::kCells; ++cell) {
+      cellLineCount[cell] = 0;
+      for (int line = 0; line < QubicGame::kLineCount; ++line)
+        if (lines[line] & (1ULL << cell))
+          cellLines[cell][cellLineCount[cell]++] = static_cast<uint8_t>(line);
+      moveOrder[cell] = static_cast<uint8_t>(cell);
+    }
+    std::stable_sort(moveOrder, moveOrder + QubicGame::kCells,
+                     [this](uint8_t a, uint8_t b) {
+                       return cellLineCount[a] > cellLineCount[b];
+                     });
+
+    uint64_t state = 0x51ED2701F3A5C2B9ULL;
+    for (auto& cell : zobrist) {
+      for (uint64_t& key : cell) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        key = z ^ (z >> 31);
+      }
+    }
+  }
+};
+const QubicTables kTables;
+
+inline int playerIndex(Player player) { return player == HUMAN ? 0 : 1; }
+}  // namespace
+
+QubicGame::QubicGame()
+    : table(nullptr),
+      useOwnTable(true),
+      searchNodes(0),
+      nodeBudget(0),
+      searchAborted(false),
+      lastScore(0) {
+  resetGame();
+}
+
+void QubicGame::resetGame() {
+  stones[0] = stones[1] = 0;
+  hash = 0;
+  currentPlayer = HUMAN;
+  winner = NONE;
+  history.clear();
+  history.reserve(kCells);
+}
+
+const uint64_t* QubicGame::lineMasks() { return kTables.lines; }
+
+bool QubicGame::hasLine(uint64_t own) {
+  for (uint64_t line : kTables.lines)
+    if ((own & line) == line) return true;
+  return false;
+}
+
+bool QubicGame::isLegalMove(int cell) const {
+  return cell >= 0 && cell < kCells && winner == NONE &&
+         !((stones[0] | stones[1]) & (1ULL << cell));
+}
+
+bool QubicGame::makeMove(int cell) {
+  if (!isLegalMove(cell)) return false;
+  doMove(cell);
+  return true;
+}
+
+bool QubicGame::undoMove() {
+  if (history.empty()) return false;
+  undoLastMove();
+  return true;
+}
+
+Player QubicGame::getCell(int cell) const {
+  if (cell < 0 || cell >= kCells) return NONE;
+  if (stones[0] & (1ULL << cell)) return HUMAN;
+  if (stones[1] & (1ULL << cell)) return AI;
+  return NONE;
+}
+
+bool QubicGame::completesLine(int cell, uint64_t own) const {
+  // Only lines through the last stone can have just been completed
+  for (int i = 0; i < kTables.cellLineCount[cell]; ++i) {
+    uint64_t line = kTables.lines[kTables.cellLines[cell][i]];
+    if ((own & line) == line) return true;
+  }
+  return false;
+}
+
+void QubicGame::doMove(int cell) {
+  int p = playerIndex(currentPlayer);
+  stones[p] |= 1ULL << cell;
+  hash ^= kTables.zobrist[cell][p];
+  history.push_back(cell);
+  if (completesLine(cell, stones[p])) winner = currentPlayer;
+  currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
+}
+
+void QubicGame::undoLastMove() {
+  int cell = history.back();
+  history.pop_back();
+  currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
+  int p = playerIndex(currentPlayer);
+  stones[p] &= ~(1ULL << cell);
+  hash ^= kTables.zobrist[cell][p];
+  winner = NONE;  // play stops at a win, so only the last move can win
+}
+
+int QubicGame::evaluate() const {
+  int p = playerIndex(currentPlayer);
+  uint64_t own = stones[p];
+  uint64_t other = stones[1 - p];
+  int score = 0;
+  for (uint64_t line : kTables.lines) {
+    bool ownIn = own & line;
+    bool otherIn = other & line;
+    if (ownIn && !otherIn)
+      score += kLineWeights[popcount(own & line)];
+    else if (otherIn && !ownIn)
+      score -= kLineWeights[popcount(other & line)];
+  }
+  return score;
+}
+
+int QubicGame::negamax(int depth, int ply, int alpha, int beta) {
+  if (++searchNodes > nodeBudget) {
+    searchAborted = true;
+    return 0;
+  }
+
+  if (winner != NONE) return -(kWinScore - ply);  // previous mover won
+  if (isBoardFull()) return 0;
+  if (depth <= 0) return evaluate();
+
+  uint64_t key = hash ^ kTableSalt ^ (currentPlayer == AI ? kSideKey : 0);
+  int ttMove = -1;
+  TTEntry entry;
+  if (table && table->probe(key, entry)) {
+    ttMove = entry.bestMove;
+    if (entry.depth >= depth) {
+      int score = entry.score;
+      // Mate scores are stored relative to the node
+      if (score > kWinScore - kMateWindow) score -= ply;
+      if (score < -kWinScore + kMateWindow) score += ply;
+      if (entry.bound == TT_EXACT) return score;
+      if (entry.bound == TT_LOWER && score >= beta) return score;
+      if (entry.bound == TT_UPPER && score <= alpha) return score;
+    }
+  }
+
+  int originalAlpha = alpha;
+  int best = -kWinScore - 1;
+  int bestMove = -1;
+  uint64_t occupied = stones[0] | stones[1];
+
+  for (int i = -1; i < kCells; ++i) {
+    int cell = (i < 0) ? ttMove : kTables.moveOrder[i];
+    if (cell < 0 || (occupied & (1ULL << cell))) continue;
+    if (i >= 0 && cell == ttMove) continue;
+
+    doMove(cell);
+    int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+    undoLastMove();
+    if (searchAborted) return 0;
+
+    if (score > best) {
+      best = score;
+      bestMove = cell;
+    }
+    alpha = std::max(alpha, score);
+    if (alpha >= beta) break;
+  }
+
+  if (table) {
+    int stored = best;
+    if (stored > kWinScore - kMateWindow) stored += ply;
+    if (stored < -kWinScore + kMateWindow) stored -= ply;
+    TTBound bound = best <= originalAlpha ? TT_UPPER
+                    : best >= beta        ? TT_LOWER
+                                          : TT_EXACT;
+    table->store(key, stored, depth, bound, bestMove);
+  }
+  return best;
+}
+
+void QubicGame::setTranspositionTable(TranspositionTable* value) {
+  table = value;
+  ownTable.reset();
+  useOwnTable = false;
+}
+
+int QubicGame::getBestMove(int maxDepth, long budget) {
+  if (isGameOver()) return -1;
+  if (useOwnTable && !ownTable) {
+    ownTable = std::make_shared<TranspositionTable>();
+    table = ownTable.get();
+  }
+
+  searchNodes = 0;
+  nodeBudget = budget;
+  searchAborted = false;
+  if (table) table->newSearch();
+
+  uint64_t occupied = stones[0] | stones[1];
+  int bestMove = -1;
+  for (int i = 0; i < kCells && bestMove < 0; ++i)
+    if (!(occupied & (1ULL << kTables.moveOrder[i])))
+      bestMove = kTables.moveOrder[i];
+
+  int remaining = kCells - popcount(occupied);
+  for (int depth = 1; depth <= std::min(maxDepth, remaining); ++depth) {
+    int alpha = -kWinScore - 1;
+    int iterBest = -1;
+    int iterScore = -kWinScore - 1;
+
+    // Previous iteration's best move first
+    for (int i = -1; i < kCells; ++i) {
+      int cell = (i < 0) ? bestMove : kTables.moveOrder[i];
+      if (occupied & (1ULL << cell)) continue;
+      if (i >= 0 && cell == bestMove) continue;
+
+      doMove(cell);
+      int score = -negamax(depth - 1, 1, -kWinScore - 1, -alpha);
+      undoLastMove();
+      if (searchAborted) break;
+
+      if (score > iterScore) {
+        iterScore = score;
+        iterBest = cell;
+      }
+      alpha = std::max(alpha, score);
+    }
+    if (searchAborted) break;
+
+    bestMove = iterBest;
+    lastScore = iterScore;
+    if (std::abs(iterScore) > kWinScore - kMateWindow) break;  // proven
+  }
+  return bestMove;
+}
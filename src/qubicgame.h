@@ -0,0 +1,76 @@
+#ifndef QUBICGAME_H
+#define QUBICGAME_H
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tictactoegame.h"  // Player
+#include "transpositiontable.h"
+
+// 3D Tic-Tac-Toe on a 4x4x4 cube (Qubic). Cell index is
+// layer * 16 + row * 4 + col, so each player's stones fit one uint64_t and
+// the 76 winning lines are a table of 64-bit masks.
+class QubicGame {
+ public:
+  static const int kCells = 64;
+  static const int kLineCount = 76;
+
+  QubicGame();
+  void resetGame();
+
+  static int cellIndex(int layer, int row, int col) {
+    return layer * 16 + row * 4 + col;
+  }
+
+  // The player to move places a stone; the turn passes automatically
+  bool makeMove(int cell);
+  bool undoMove();
+  bool isLegalMove(int cell) const;
+
+  Player getCell(int cell) const;
+  Player getCurrentPlayer() const { return currentPlayer; }
+  Player getWinner() const { return winner; }
+  bool isBoardFull() const { return (stones[0] | stones[1]) == ~0ULL; }
+  bool isGameOver() const { return winner != NONE || isBoardFull(); }
+  uint64_t getStones(Player player) const {
+    return stones[player == HUMAN ? 0 : 1];
+  }
+  uint64_t getHash() const { return hash; }
+
+  // Iterative deepening alpha-beta limited by depth and node budget
+  int getBestMove(int maxDepth, long nodeBudget = 2000000);
+  int getLastScore() const { return lastScore; }
+  long getLastSearchNodes() const { return searchNodes; }
+
+  // As for TicTacToeGame, each game caches in a table of its own, created
+  // on its first search, so a budgeted search depends only on this game.
+  // Pass &TranspositionTable::shared() to share, or nullptr to disable.
+  void setTranspositionTable(TranspositionTable* value);
+
+  static const uint64_t* lineMasks();
+  static bool hasLine(uint64_t stones);
+
+ private:
+
+  uint64_t stones[2];
+  uint64_t hash;
+  Player currentPlayer;
+  Player winner;
+  std::vector<int> history;
+
+  TranspositionTable* table;  // nullptr disables caching
+  std::shared_ptr<TranspositionTable> ownTable;
+  bool useOwnTable;
+  long searchNodes;
+  long nodeBudget;
+  bool searchAborted;
+  int lastScore;
+
+  void doMove(int cell);
+  void undoLastMove();
+  bool completesLine(int cell, uint64_t own) const;
+  int evaluate() const;
+  int negamax(int depth, int ply, int alpha, int beta);
+};
+#endif  // QUBICGAME_H
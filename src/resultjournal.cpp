@@ -0,0 +1,176 @@
+#include "resultjournal.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSet>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+const quint32 kEntryMagic = 0x544a524e;  // "TJRN"
+const int kHeaderSize = 10;              // magic, payload size, checksum
+
+// Journals open in this process; a second opener must not replay or
+// trim entries the first one is still writing
+QMutex openPathsMutex;
+QSet<QString> openPaths;
+
+QByteArray serialize(const JournalEntry& entry) {
+  QByteArray payload;
+  QDataStream out(&payload, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_5_0);
+  out << entry.sequence << entry.username << qint32(entry.won)
+      << qint32(entry.lost) << qint32(entry.tied) << entry.hasGame;
+  if (entry.hasGame) {
+    const GameRecord& game = entry.game;
+    out << game.timestamp << game.opponent << game.result << game.gameMode
+        << game.playerSymbol << qint32(game.moves.size());
+    for (const GameMove& move : game.moves)
+      out << qint8(move.row) << qint8(move.col) << qint8(move.player);
+  }
+  return payload;
+}
+
+bool deserialize(const QByteArray& payload, JournalEntry& entry) {
+  QDataStream in(payload);
+  in.setVersion(QDataStream::Qt_5_0);
+  qint32 won, lost, tied;
+  in >> entry.sequence >> entry.username >> won >> lost >> tied >>
+      entry.hasGame;
+  entry.won = won;
+  entry.lost = lost;
+  entry.tied = tied;
+  if (entry.hasGame) {
+    GameRecord& game = entry.game;
+    qint32 count;
+    in >> game.timestamp >> game.opponent >> game.result >> game.gameMode >>
+        game.playerSymbol >> count;
+    if (count < 0 || count > payload.size()) return false;
+    for (int i = 0; i < count; ++i) {
+      qint8 row, col, player;
+      in >> row >> col >> player;
+      game.moves.append(GameMove(row, col, player));
+    }
+  }
+  return in.status() == QDataStream::Ok;
+}
+}  // namespace
+
+bool ResultJournal::open(const QString& path, qint64 appliedSequence) {
+  close();
+  QString key = QFileInfo(path).absoluteFilePath();
+  {
+    QMutexLocker lock(&openPathsMutex);
+    if (openPaths.contains(key)) {
+      qDebug() << "Result journal already in use:" << key;
+      return false;
+    }
+    openPaths.insert(key);
+  }
+
+  file.setFileName(path);
+  if (!file.open(QIODevice::ReadWrite)) {
+    qDebug() << "Error opening result journal:" << file.errorString();
+    close();
+    return false;
+  }
+
+  // Read whole entries up to the first torn or corrupt one
+  QByteArray data = file.readAll();
+  QDataStream in(data);
+  qint64 validSize = 0;
+  while (data.size() - validSize >= kHeaderSize) {
+    quint32 magic, size;
+    quint16 checksum;
+    in >> magic >> size >> checksum;
+    if (magic != kEntryMagic || size > quint32(data.size() - validSize -
+                                               kHeaderSize))
+      break;
+    QByteArray payload = data.mid(validSize + kHeaderSize, size);
+    JournalEntry entry;
+    if (qChecksum(payload.constData(), payload.size()) != checksum ||
+        !deserialize(payload, entry))
+      break;
+    in.skipRawData(size);
+    pending.append(entry);
+    validSize += kHeaderSize + size;
+  }
+
+  if (validSize < data.size()) {
+    qDebug() << "Result journal: dropping" << data.size() - validSize
+             << "bytes of incomplete entry";
+    file.resize(validSize);
+  }
+  file.seek(validSize);
+
+  last = appliedSequence;
+  if (!pending.isEmpty()) last = qMax(last, pending.last().sequence);
+
+  // Entries a commit already applied, left by a crash before the discard
+  if (!pending.isEmpty() && pending.first().sequence <= appliedSequence)
+    return discardThrough(appliedSequence);
+  return true;
+}
+
+void ResultJournal::close() {
+  if (file.isOpen()) file.close();
+  if (!file.fileName().isEmpty()) {
+    QMutexLocker lock(&openPathsMutex);
+    openPaths.remove(QFileInfo(file.fileName()).absoluteFilePath());
+    file.setFileName(QString());
+  }
+  pending.clear();
+  last = 0;
+}
+
+bool ResultJournal::append(JournalEntry& entry) {
+  // A sequence from a journal that is not open would restart at 1 and
+  // clobber the applied position of the manager that owns the file
+  if (!file.isOpen()) return false;
+  entry.sequence = ++last;
+  pending.append(entry);
+  return writeEntry(entry) && sync();
+}
+
+bool ResultJournal::discardThrough(qint64 sequence) {
+  while (!pending.isEmpty() && pending.first().sequence <= sequence)
+    pending.removeFirst();
+
+  if (!file.isOpen()) return false;
+  bool ok = file.resize(0) && file.seek(0);
+  for (const JournalEntry& entry : pending) ok = ok && writeEntry(entry);
+  return ok && sync();
+}
+
+bool ResultJournal::writeEntry(const JournalEntry& entry) {
+  if (!file.isOpen()) return false;
+
+  QByteArray payload = serialize(entry);
+  QByteArray record;
+  QDataStream out(&record, QIODevice::WriteOnly);
+  out << kEntryMagic << quint32(payload.size())
+      << qChecksum(payload.constData(), payload.size());
+  record.append(payload);
+
+  if (file.write(record) != record.size()) {
+    qDebug() << "Error writing result journal:" << file.errorString();
+    return false;
+  }
+  return true;
+}
+
+bool ResultJournal::sync() {
+  // QFile::flush only reaches the OS; the entry must reach the disk
+  if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+  return _commit(file.handle()) == 0;
+#else
+  return ::fsync(file.handle()) == 0;
+#endif
+}
@@ -0,0 +1,52 @@
+#ifndef RESULTJOURNAL_H
+#define RESULTJOURNAL_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include "user.h"
+
+// One finished game as journaled: stat changes for the user and, when the
+// game is kept in history, its record
+struct JournalEntry {
+  qint64 sequence = 0;  // assigned by the journal, increasing
+  QString username;
+  int won = 0;
+  int lost = 0;
+  int tied = 0;
+  bool hasGame = false;
+  GameRecord game;
+};
+
+// Append-only file of results not yet written to SQLite. Every append is
+// synced to disk before it returns, so an entry survives a crash; a torn
+// entry at the tail is detected by its checksum and ignored. A file can
+// be open in only one journal per process.
+class ResultJournal {
+ public:
+  // Reads back the entries already in the file. Sequences continue after
+  // both those entries and appliedSequence.
+  bool open(const QString& path, qint64 appliedSequence);
+  void close();
+
+  // Fails without queueing the entry when the journal is not open
+  bool append(JournalEntry& entry);
+  // Drops entries up to and including sequence, keeping any later ones
+  bool discardThrough(qint64 sequence);
+
+  bool isOpen() const { return file.isOpen(); }
+  const QList<JournalEntry>& entries() const { return pending; }
+  bool isEmpty() const { return pending.isEmpty(); }
+  qint64 lastSequence() const { return last; }
+
+ private:
+  bool writeEntry(const JournalEntry& entry);
+  bool sync();
+
+  QFile file;
+  QList<JournalEntry> pending;
+  qint64 last = 0;
+};
+
+#endif  // RESULTJOURNAL_H
@@ -0,0 +1,306 @@
+#ifndef RULEVARIANTS_H
+#define RULEVARIANTS_H
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "tictactoegame.h"  // Player
+
+// Rule variants as compile-time policies. A placement policy decides which
+// moves are legal and where a stone lands; a win policy decides whether
+// completing K in a row wins or loses. VariantGame is instantiated per rule
+// set, so the search loops contain no runtime rule checks.
+//
+// Cells are numbered row * Cols + col with row 0 at the bottom, and each
+// player's stones are one uint64_t (Rows * Cols <= 64).
+
+template <int Rows, int Cols, int K>
+struct VariantGeometry {
+  static_assert(Rows * Cols <= 64, "board must fit a 64-bit bitboard");
+  static_assert(K <= Rows || K <= Cols, "K must fit on the board");
+  static const int kCells = Rows * Cols;
+
+  std::vector<uint64_t> lines;
+  std::vector<std::vector<uint64_t>> cellLines;  // lines through each cell
+  uint64_t columnMasks[Cols];
+  int cellOrder[kCells];    // cells on most lines first
+  int columnOrder[Cols];    // centre columns first
+
+  static const VariantGeometry& get() {
+    static const VariantGeometry geometry;
+    return geometry;
+  }
+
+ private:
+  VariantGeometry() : cellLines(kCells) {
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : directions) {
+      for (int r = 0; r < Rows; ++r) {
+        for (int c = 0; c < Cols; ++c) {
+          int er = r + (K - 1) * d[0];
+          int ec = c + (K - 1) * d[1];
+          if (er < 0 || er >= Rows || ec < 0 || ec >= Cols) continue;
+          uint64_t mask = 0;
+          for (int step = 0; step < K; ++step)
+            mask |= 1ULL << ((r + step * d[0]) * Cols + c + step * d[1]);
+          lines.push_back(mask);
+        }
+      }
+    }
+
+    for (int cell = 0; cell < kCells; ++cell) {
+      for (uint64_t line : lines)
+        if (line & (1ULL << cell)) cellLines[cell].push_back(line);
+      cellOrder[cell] = cell;
+    }
+    std::stable_sort(cellOrder, cellOrder + kCells, [this](int a, int b) {
+      return cellLines[a].size() > cellLines[b].size();
+    });
+
+    for (int c = 0; c < Cols; ++c) {
+      columnMasks[c] = 0;
+      for (int r = 0; r < Rows; ++r) columnMasks[c] |= 1ULL << (r * Cols + c);
+      columnOrder[c] = c;
+    }
+    std::stable_sort(columnOrder, columnOrder + Cols, [](int a, int b) {
+      return std::abs(2 * a - (Cols - 1)) < std::abs(2 * b - (Cols - 1));
+    });
+  }
+};
+
+// Any empty cell may be played; a move is a cell index
+struct FreePlacement {
+  template <class Geometry>
+  static int generate(const Geometry& g, uint64_t occupied, int* moves) {
+    int count = 0;
+    for (int cell : g.cellOrder)
+      if (!(occupied & (1ULL << cell))) moves[count++] = cell;
+    return count;
+  }
+
+  template <class Geometry>
+  static int landingCell(const Geometry&, uint64_t occupied, int move) {
+    if (move < 0 || move >= Geometry::kCells) return -1;
+    return (occupied & (1ULL << move)) ? -1 : move;
+  }
+};
+
+// Connect-Four style drops; a move is a column index and the stone lands
+// on the lowest empty row of that column
+struct GravityPlacement {
+  template <class Geometry>
+  static int generate(const Geometry& g, uint64_t occupied, int* moves) {
+    int count = 0;
+    for (int col : g.columnOrder)
+      if ((occupied & g.columnMasks[col]) != g.columnMasks[col])
+        moves[count++] = col;
+    return count;
+  }
+
+  template <class Geometry>
+  static int landingCell(const Geometry& g, uint64_t occupied, int move) {
+    const int cols = sizeof(g.columnMasks) / sizeof(g.columnMasks[0]);
+    if (move < 0 || move >= cols) return -1;
+    // Columns fill bottom-up, so the stone count is the landing row
+    int height = __builtin_popcountll(occupied & g.columnMasks[move]);
+    int cell = height * cols + move;
+    return cell < Geometry::kCells ? cell : -1;
+  }
+};
+
+// kSign is +1 when completing a line wins and -1 when it loses
+struct NormalWin {
+  static const int kSign = 1;
+};
+struct MisereWin {
+  static const int kSign = -1;
+};
+
+template <int Rows, int Cols, int K, class Placement, class WinRule>
+class VariantGame {
+ public:
+  typedef VariantGeometry<Rows, Cols, K> Geometry;
+  static const int kCells = Geometry::kCells;
+
+  VariantGame()
+      : searchNodes(0), nodeBudget(0), searchAborted(false), lastScore(0) {
+    resetGame();
+  }
+
+  void resetGame() {
+    stones[0] = stones[1] = 0;
+    currentPlayer = HUMAN;
+    lineMaker = NONE;
+    history.clear();
+  }
+
+  // Legal moves in the policy's move space (cells or columns)
+  int generateMoves(int* moves) const {
+    if (isGameOver()) return 0;
+    return Placement::generate(Geometry::get(), stones[0] | stones[1], moves);
+  }
+
+  bool makeMove(int move) {
+    if (isGameOver()) return false;
+    int cell =
+        Placement::landingCell(Geometry::get(), stones[0] | stones[1], move);
+    if (cell < 0) return false;
+    doMove(cell);
+    return true;
+  }
+
+  bool undoMove() {
+    if (history.empty()) return false;
+    undoLastMove();
+    return true;
+  }
+
+  Player getCell(int row, int col) const {
+    uint64_t bit = 1ULL << (row * Cols + col);
+    if (stones[0] & bit) return HUMAN;
+    if (stones[1] & bit) return AI;
+    return NONE;
+  }
+  Player getCurrentPlayer() const { return currentPlayer; }
+  bool isBoardFull() const {
+    return (stones[0] | stones[1]) == fullMask();
+  }
+  bool isGameOver() const { return lineMaker != NONE || isBoardFull(); }
+
+  // Under misère the player who completed a line is the loser
+  Player getWinner() const {
+    if (lineMaker == NONE) return NONE;
+    if (WinRule::kSign > 0) return lineMaker;
+    return lineMaker == HUMAN ? AI : HUMAN;
+  }
+
+  // Iterative deepening alpha-beta; with enough depth and budget it solves
+  // the position exactly. Returns a move in the policy's move space.
+  int getBestMove(int maxDepth, long budget = 2000000) {
+    int moves[kCells];
+    int count = generateMoves(moves);
+    if (count == 0) return -1;
+
+    searchNodes = 0;
+    nodeBudget = budget;
+    searchAborted = false;
+
+    int bestIndex = 0;
+    int remaining = kCells - __builtin_popcountll(stones[0] | stones[1]);
+    for (int depth = 1; depth <= std::min(maxDepth, remaining); ++depth) {
+      int alpha = -kWinScore - 1;
+      int iterIndex = -1;
+      int iterScore = -kWinScore - 1;
+      // Previous best first, then the static order
+      for (int i = -1; i < count; ++i) {
+        int index = (i < 0) ? bestIndex : i;
+        if (i == bestIndex) continue;
+        makeMove(moves[index]);
+        int score = -negamax(depth - 1, 1, -kWinScore - 1, -alpha);
+        undoLastMove();
+        if (searchAborted) break;
+        if (score > iterScore) {
+          iterScore = score;
+          iterIndex = index;
+        }
+        alpha = std::max(alpha, score);
+      }
+      if (searchAborted) break;
+      bestIndex = iterIndex;
+      lastScore = iterScore;
+      if (std::abs(iterScore) > kWinScore - kCells - 1) break;  // proven
+    }
+    return moves[bestIndex];
+  }
+
+  int getLastScore() const { return lastScore; }
+  long getLastSearchNodes() const { return searchNodes; }
+
+ private:
+  static const int kWinScore = 10000;
+
+  uint64_t stones[2];
+  Player currentPlayer;
+  Player lineMaker;  // player who completed a line, if any
+  std::vector<int> history;
+  long searchNodes;
+  long nodeBudget;
+  bool searchAborted;
+  int lastScore;
+
+  static uint64_t fullMask() {
+    return kCells == 64 ? ~0ULL : ((1ULL << kCells) - 1);
+  }
+
+  void doMove(int cell) {
+    int p = (currentPlayer == HUMAN) ? 0 : 1;
+    stones[p] |= 1ULL << cell;
+    history.push_back(cell);
+    for (uint64_t line : Geometry::get().cellLines[cell]) {
+      if ((stones[p] & line) == line) {
+        lineMaker = currentPlayer;
+        break;
+      }
+    }
+    currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
+  }
+
+  void undoLastMove() {
+    int cell = history.back();
+    history.pop_back();
+    currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
+    stones[currentPlayer == HUMAN ? 0 : 1] &= ~(1ULL << cell);
+    lineMaker = NONE;  // play stops at the first line
+  }
+
+  // Open-line count from the side to move; flipped under misère
+  int evaluate() const {
+    int p = (currentPlayer == HUMAN) ? 0 : 1;
+    uint64_t own = stones[p];
+    uint64_t other = stones[1 - p];
+    int score = 0;
+    for (uint64_t line : Geometry::get().lines) {
+      int ownCount = __builtin_popcountll(own & line);
+      int otherCount = __builtin_popcountll(other & line);
+      score += (otherCount == 0) * ownCount * ownCount;
+      score -= (ownCount == 0) * otherCount * otherCount;
+    }
+    return WinRule::kSign * score;
+  }
+
+  int negamax(int depth, int ply, int alpha, int beta) {
+    if (++searchNodes > nodeBudget) {
+      searchAborted = true;
+      return 0;
+    }
+
+    // The previous mover completed a line: a loss for the side to move
+    // under normal rules, a win under misère
+    if (lineMaker != NONE) return -WinRule::kSign * (kWinScore - ply);
+    if (isBoardFull()) return 0;
+    if (depth <= 0) return evaluate();
+
+    int moves[kCells];
+    int count =
+        Placement::generate(Geometry::get(), stones[0] | stones[1], moves);
+    int best = -kWinScore - 1;
+    for (int i = 0; i < count; ++i) {
+      makeMove(moves[i]);
+      int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+      undoLastMove();
+      if (searchAborted) return 0;
+      best = std::max(best, score);
+      alpha = std::max(alpha, score);
+      if (alpha >= beta) break;
+    }
+    return best;
+  }
+};
+
+// Ready-made rule sets
+typedef VariantGame<3, 3, 3, FreePlacement, MisereWin> MisereTicTacToe;
+typedef VariantGame<6, 7, 4, GravityPlacement, NormalWin> GravityFourGame;
+typedef VariantGame<6, 7, 4, GravityPlacement, MisereWin> GravityMisereGame;
+
+#endif  // RULEVARIANTS_H
@@ -0,0 +1,354 @@
+#include "searchtask.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <random>
+
+namespace {
+const int kWinScore = TicTacToeGame::kWinScore;
+const int kProven = kWinScore - 9;  // scores beyond this are forced results
+const int kMaxNoise = 2000;  // noise range at strength 0.0 (fully random)
+
+// Mixed into table keys so 3x3 positions never alias other engines' entries,
+// and to tell apart the same stones with a different side to move
+const uint64_t kTableSalt = 0x3C3C3C3C0F0F0F0FULL;
+const uint64_t kSideKey = 0xD1B54A32D192ED03ULL;
+
+// Win scores are stored relative to the node, not the root
+int toTableScore(int score, int ply) {
+  if (score >= kProven) return score + ply;
+  if (score <= -kProven) return score - ply;
+  return score;
+}
+
+int fromTableScore(int score, int ply) {
+  if (score >= kProven) return score - ply;
+  if (score <= -kProven) return score + ply;
+  return score;
+}
+}  // namespace
+
+SearchTask::SearchTask(TicTacToeGame& game, Player toMove, bool exact)
+    : position(game),
+      rootPlayer(toMove),
+      rootOpponent(toMove == HUMAN ? AI : HUMAN),
+      exactMode(exact),
+      finished(false),
+      noiseRange(0),
+      haveScores(false),
+      pvLines(0),
+      rootMoveCount(game.moveCount),
+      rootWindow(-kWinScore - 1),
+      depth(1),
+      completedDepth(0),
+      rootIndex(0),
+      bestCell(-1),
+      bestScore(0),
+      top(0) {
+  for (int cell = 0; cell < 9; ++cell)
+    if (position.board[cell / 3][cell % 3] == NONE) moves.push_back(cell);
+
+  // The game's own table outlives this task and serves its later searches
+  game.prepareTable();
+  position.table = game.table;
+  position.ownTable = game.ownTable;
+
+  position.searchNodes = 0;
+  position.searchAborted = false;
+  position.nodeBudget =
+      exact ? LONG_MAX : TicTacToeGame::nodeBudgetForStrength(game.strength);
+  if (position.table) position.table->newSearch();
+
+  maxDepth = static_cast<int>(moves.size());
+  if (exact) depth = maxDepth;
+
+  noise.assign(moves.size(), 0);
+  scores.assign(moves.size(), 0);
+  iterScores.assign(moves.size(), 0);
+  exactScores.assign(moves.size(), true);
+  iterExact.assign(moves.size(), true);
+
+  if (!exact && !moves.empty()) {
+    // Noise is drawn once per root move so every depth iteration sees the
+    // same perturbation and the result depends only on the seed. The
+    // fallback for a budget too small for one ply is drawn up front too.
+    double weakness = 1.0 - game.strength;
+    noiseRange = static_cast<int>(kMaxNoise * weakness * weakness);
+    if (noiseRange > 0) {
+      std::uniform_int_distribution<int> dist(0, noiseRange);
+      for (int& n : noise) n = dist(game.rng);
+    }
+    std::uniform_int_distribution<int> pick(0, int(moves.size()) - 1);
+    bestCell = moves[pick(game.rng)];
+  }
+
+  if (moves.empty() || position.checkWin(HUMAN) || position.checkWin(AI)) {
+    finished = true;
+    bestCell = -1;
+  }
+}
+
+void SearchTask::setMultiPV(int lineCount) {
+  pvLines = lineCount;
+  noiseRange = 0;
+  noise.assign(moves.size(), 0);
+}
+
+std::pair<int, int> SearchTask::getMove() const {
+  if (bestCell < 0) return std::make_pair(-1, -1);
+  return std::make_pair(bestCell / 3, bestCell % 3);
+}
+
+bool SearchTask::enter(int nodeDepth, int ply, int alpha, int beta,
+                       Player toMove, Player opponent, int& value) {
+  TicTacToeGame& p = position;
+  if (++p.searchNodes > p.nodeBudget) {
+    p.searchAborted = true;
+    return true;
+  }
+
+  // The side that just moved is the only one who can have completed a line
+  if (p.checkWin(opponent)) {
+    value = -(kWinScore - ply);
+    return true;
+  }
+  if (p.isBoardFull()) {
+    value = 0;
+    return true;
+  }
+  if (nodeDepth <= 0) {
+    value = p.heuristicScore(toMove);
+    return true;
+  }
+
+  uint64_t key = tableKey(toMove);
+  int ttMove = -1;
+  TTEntry entry;
+  if (p.table && p.table->probe(key, entry)) {
+    ttMove = entry.bestMove;
+    if (entry.depth >= nodeDepth) {
+      int score = fromTableScore(entry.score, ply);
+      if (entry.bound == TT_EXACT ||
+          (entry.bound == TT_LOWER && score >= beta) ||
+          (entry.bound == TT_UPPER && score <= alpha)) {
+        value = score;
+        return true;
+      }
+    }
+  }
+
+  Frame& frame = frames[top++];
+  frame = {nodeDepth, ply, alpha, beta, alpha, toMove, opponent,
+           key,       ttMove, -1, -kWinScore - 1, -1};
+
+  if (nodeDepth == 1) {
+    // Frontier: every child is a leaf, evaluated in one batch
+    frame.best = p.evaluateFrontier(ply, toMove, opponent, frame.bestMove);
+    if (p.searchAborted) return true;
+    frame.next = 9;
+    finishFrame(value);
+    return true;
+  }
+  return false;
+}
+
+void SearchTask::finishFrame(int& value) {
+  Frame& frame = frames[--top];
+  if (position.table) {
+    TTBound bound = frame.best <= frame.originalAlpha ? TT_UPPER
+                    : frame.best >= frame.beta        ? TT_LOWER
+                                                      : TT_EXACT;
+    position.table->store(frame.key, toTableScore(frame.best, frame.ply),
+                          frame.depth, bound, frame.bestMove);
+  }
+  value = frame.best;
+}
+
+void SearchTask::deliver(int value) {
+  // Hand a child's value up the stack until a frame still has work to do
+  while (true) {
+    position.undoLastMove();
+    if (top == 0) {
+      iterExact[rootIndex] = -value > rootWindow;
+      iterScores[rootIndex++] = -value;
+      return;
+    }
+
+    Frame& frame = frames[top - 1];
+    int score = -value;
+    if (score > frame.best) {
+      frame.best = score;
+      frame.bestMove = position.moveStack[position.moveCount].cell;
+    }
+    frame.alpha = std::max(frame.alpha, score);
+    if (frame.alpha < frame.beta) return;
+    finishFrame(value);  // cutoff
+  }
+}
+
+bool SearchTask::step(long maxNodes) {
+  TicTacToeGame& p = position;
+  long stopAt = p.searchNodes + maxNodes;
+  if (maxNodes == LONG_MAX || stopAt < p.searchNodes) stopAt = LONG_MAX;
+
+  while (!finished && p.searchNodes < stopAt) {
+    int value = 0;
+    if (top == 0) {
+      if (rootIndex == moves.size()) {
+        finishIteration();
+        continue;
+      }
+      // Full window per root move unless multi-PV: noise needs exact
+      // scores, not bounds
+      rootWindow = rootAlpha();
+      p.doMove(moves[rootIndex], rootPlayer);
+      if (enter(depth - 1, 1, -kWinScore - 1, -rootWindow, rootOpponent,
+                rootPlayer, value) &&
+          !p.searchAborted)
+        deliver(value);
+    } else {
+      Frame& frame = frames[top - 1];
+      int cell = -1;
+      while (frame.next < 9 && cell < 0) {
+        int candidate = frame.next < 0 ? frame.ttMove : frame.next;
+        bool duplicate = frame.next >= 0 && candidate == frame.ttMove;
+        ++frame.next;
+        if (candidate >= 0 && !duplicate &&
+            p.board[candidate / 3][candidate % 3] == NONE)
+          cell = candidate;
+      }
+
+      if (cell < 0) {
+        finishFrame(value);
+        deliver(value);
+      } else {
+        p.doMove(cell, frame.toMove);
+        if (enter(frame.depth - 1, frame.ply + 1, -frame.beta, -frame.alpha,
+                  frame.opponent, frame.toMove, value) &&
+            !p.searchAborted)
+          deliver(value);
+      }
+    }
+
+    // Out of budget: keep the last complete iteration
+    if (p.searchAborted) finish();
+  }
+  return finished;
+}
+
+uint64_t SearchTask::tableKey(Player toMove) const {
+  return position.hash ^ kTableSalt ^ position.evaluator->tableSalt() ^
+         (toMove == AI ? kSideKey : 0);
+}
+
+int SearchTask::rootAlpha() const {
+  // Multi-PV: once N moves are scored, a later move only has to show it
+  // cannot beat the Nth best, so its window starts at that score
+  if (pvLines <= 0 || rootIndex < static_cast<size_t>(pvLines))
+    return -kWinScore - 1;
+  std::vector<int> searched(iterScores.begin(), iterScores.begin() + rootIndex);
+  std::nth_element(searched.begin(), searched.begin() + pvLines - 1,
+                   searched.end(), std::greater<int>());
+  return searched[pvLines - 1];
+}
+
+void SearchTask::finishIteration() {
+  scores = iterScores;
+  exactScores = iterExact;
+  haveScores = true;
+  completedDepth = depth;
+
+  // A proven result cannot change with more depth
+  bool allDecided = true;
+  for (int score : scores)
+    if (std::abs(score) < kProven) allDecided = false;
+
+  if (allDecided || depth >= maxDepth) {
+    finish();
+    return;
+  }
+  ++depth;
+  rootIndex = 0;
+
+  if (pvLines > 0) {
+    // Best moves first, so the next iteration's windows close early
+    std::vector<size_t> order(moves.size());
+    for (size_t m = 0; m < order.size(); ++m) order[m] = m;
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return scores[a] > scores[b];
+    });
+    std::vector<int> sortedMoves, sortedScores;
+    for (size_t m : order) {
+      sortedMoves.push_back(moves[m]);
+      sortedScores.push_back(scores[m]);
+    }
+    moves = sortedMoves;
+    scores = sortedScores;
+  }
+}
+
+void SearchTask::finish() {
+  finished = true;
+  // An aborted search leaves the copy mid-tree
+  while (position.moveCount > rootMoveCount) position.undoLastMove();
+  top = 0;
+  if (!haveScores) return;  // keep the pre-drawn random fallback
+
+  if (pvLines > 0) {
+    buildLines();
+    bestCell = lines[0].moves[0];
+    bestScore = lines[0].score;
+    return;
+  }
+
+  // Once the noise is smaller than a win, proven results are ranked exactly
+  // (fastest win, slowest loss); only the weakest settings may misjudge them.
+  size_t best = 0;
+  int bestKey = INT_MIN;
+  for (size_t m = 0; m < moves.size(); ++m) {
+    int key = scores[m] + noise[m];
+    if (std::abs(scores[m]) >= kProven && noiseRange < kWinScore)
+      key = scores[m] + (scores[m] > 0 ? kMaxNoise : -kMaxNoise);
+    if (key > bestKey) {
+      bestKey = key;
+      best = m;
+    }
+  }
+  bestCell = moves[best];
+  bestScore = scores[best];
+}
+
+void SearchTask::buildLines() {
+  std::vector<size_t> order;
+  for (size_t m = 0; m < moves.size(); ++m)
+    if (exactScores[m]) order.push_back(m);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return scores[a] > scores[b];
+  });
+  if (order.size() > static_cast<size_t>(pvLines)) order.resize(pvLines);
+
+  TicTacToeGame& p = position;
+  for (size_t m : order) {
+    SearchLine line;
+    line.score = scores[m];
+    line.moves.push_back(moves[m]);
+
+    // Follow the cached best moves; the walk stops where the table has
+    // nothing usable for the position
+    p.doMove(moves[m], rootPlayer);
+    Player toMove = rootOpponent;
+    Player opponent = rootPlayer;
+    TTEntry entry;
+    while (p.table && !p.checkWin(opponent) && !p.isBoardFull() &&
+           p.table->probe(tableKey(toMove), entry) && entry.bestMove >= 0 &&
+           p.board[entry.bestMove / 3][entry.bestMove % 3] == NONE) {
+      line.moves.push_back(entry.bestMove);
+      p.doMove(entry.bestMove, toMove);
+      std::swap(toMove, opponent);
+    }
+    while (p.moveCount > rootMoveCount) p.undoLastMove();
+    lines.push_back(line);
+  }
+}
@@ -0,0 +1,95 @@
+#ifndef SEARCHTASK_H
+#define SEARCHTASK_H
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tictactoegame.h"
+
+// Resumable node-budgeted search over a snapshot of a TicTacToeGame.
+// The negamax recursion lives on an explicit stack, so step() can stop
+// after any number of nodes and later continue from the same point. The
+// GUI uses this to interleave search slices with event processing on a
+// single core; getAIMove simply runs one task to completion.
+class SearchTask {
+ public:
+  // exact = false: iterative deepening within the game's node budget, with
+  // noise scaled by its strength. exact = true: one full-depth search with
+  // no budget and no noise, giving exact scores for every root move.
+  SearchTask(TicTacToeGame& game, Player toMove, bool exact = false);
+
+  // Multi-PV: keep exact scores only for the best lineCount root moves.
+  // Later root moves are searched against the current Nth best score and
+  // may stop at a bound. Disables noise; call before the first step().
+  void setMultiPV(int lineCount);
+
+  // Searches at most maxNodes more nodes; returns true once finished
+  bool step(long maxNodes);
+  bool isFinished() const { return finished; }
+
+  std::pair<int, int> getMove() const;
+  int getScore() const { return bestScore; }
+  long getNodes() const { return position.searchNodes; }
+  int getCompletedDepth() const { return completedDepth; }
+
+  // Root moves (cells) and their scores from the last complete iteration
+  const std::vector<int>& getRootMoves() const { return moves; }
+  const std::vector<int>& getRootScores() const { return scores; }
+  // Multi-PV result, best first; empty unless setMultiPV was called
+  const std::vector<SearchLine>& getLines() const { return lines; }
+
+ private:
+  struct Frame {
+    int depth;
+    int ply;
+    int alpha;
+    int beta;
+    int originalAlpha;
+    Player toMove;
+    Player opponent;
+    uint64_t key;
+    int ttMove;
+    int next;  // next move-order slot; -1 means the cached move
+    int best;
+    int bestMove;
+  };
+
+  TicTacToeGame position;  // private copy; the caller's game is untouched
+  Player rootPlayer;
+  Player rootOpponent;
+  bool exactMode;
+  bool finished;
+
+  std::vector<int> moves;
+  std::vector<int> noise;
+  int noiseRange;
+  std::vector<int> scores;
+  std::vector<int> iterScores;
+  std::vector<bool> exactScores;  // false where only an upper bound is known
+  std::vector<bool> iterExact;
+  bool haveScores;
+  int pvLines;  // 0 unless multi-PV
+  std::vector<SearchLine> lines;
+  int rootMoveCount;
+  int rootWindow;  // alpha of the root move being searched
+  int depth;
+  int maxDepth;
+  int completedDepth;
+  size_t rootIndex;
+  int bestCell;
+  int bestScore;
+
+  Frame frames[10];
+  int top;
+
+  bool enter(int depth, int ply, int alpha, int beta, Player toMove,
+             Player opponent, int& value);
+  void finishFrame(int& value);
+  void deliver(int value);
+  uint64_t tableKey(Player toMove) const;
+  int rootAlpha() const;
+  void finishIteration();
+  void finish();
+  void buildLines();
+};
+#endif  // SEARCHTASK_H
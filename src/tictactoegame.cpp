@@ -1,51 +1,117 @@
 #include "tictactoegame.h"
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 
-TicTacToeGame::TicTacToeGame() {
-  std::srand(std::time(0));
+#include "searchtask.h"
+
+namespace {
+const int kWinScore = TicTacToeGame::kWinScore;
+const long kMinNodes = 16;
+const long kMaxNodes = 1L << 18;  // enough for a complete 3x3 solve
+const size_t kOwnTableSlots = 1 << 13;  // well above the 5478 positions
+
+// Lines through each cell, terminated by -1. Lines 0-2 are rows, 3-5 columns,
+// 6 the main diagonal and 7 the anti-diagonal.
+const int kCellLines[9][5] = {{0, 3, 6, -1}, {0, 4, -1},       {0, 5, 7, -1},
+                              {1, 3, -1},    {1, 4, 6, 7, -1}, {1, 5, -1},
+                              {2, 3, 7, -1}, {2, 4, -1},       {2, 5, 6, -1}};
+
+// Zobrist keys per cell and player, generated from a fixed seed so hashes
+// are stable across runs and processes
+struct ZobristKeys {
+  uint64_t keys[9][3];
+  ZobristKeys() {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (auto& cell : keys) {
+      for (uint64_t& key : cell) {
+        // splitmix64
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        key = z ^ (z >> 31);
+      }
+    }
+  }
+};
+const ZobristKeys kZobrist;
+
+LineEvaluator defaultEvaluator;
+}  // namespace
+
+TicTacToeGame::TicTacToeGame()
+    : rng(static_cast<unsigned int>(std::time(0))),
+      searchNodes(0),
+      nodeBudget(0),
+      searchAborted(false),
+      table(nullptr),
+      useOwnTable(true),
+      evaluator(&defaultEvaluator) {
   resetGame();
-  difficultyLevel = 1;
+  setDifficulty(1);
   gameMode = true;  // Default to PvP
 }
 
 void TicTacToeGame::resetGame() {
   for (int i = 0; i < 3; ++i)
     for (int j = 0; j < 3; ++j) board[i][j] = NONE;
+  for (auto& line : lineCount) line[0] = line[1] = line[2] = 0;
+  completedLines[0] = completedLines[1] = completedLines[2] = 0;
+  hash = 0;
+  moveCount = 0;
+  redoCount = 0;
   currentPlayer = HUMAN;
 }
 
 bool TicTacToeGame::makeMove(int row, int col, Player player) {
-  if (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == NONE) {
-    board[row][col] = player;
+  if (row >= 0 && row < 3 && col >= 0 && col < 3 && board[row][col] == NONE &&
+      player != NONE) {
+    doMove(row * 3 + col, player);
+    redoCount = 0;
     return true;
   }
   return false;
 }
 
-bool TicTacToeGame::isBoardFull() const {
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      if (board[i][j] == NONE) return false;
+void TicTacToeGame::doMove(int cell, Player player) {
+  board[cell / 3][cell % 3] = player;
+  for (const int* line = kCellLines[cell]; *line >= 0; ++line)
+    if (++lineCount[*line][player] == 3) ++completedLines[player];
+  hash ^= kZobrist.keys[cell][player];
+  moveStack[moveCount++] = {cell, player, currentPlayer, currentPlayer};
+}
+
+void TicTacToeGame::undoLastMove() {
+  const MoveRecord& move = moveStack[--moveCount];
+  board[move.cell / 3][move.cell % 3] = NONE;
+  for (const int* line = kCellLines[move.cell]; *line >= 0; ++line)
+    if (lineCount[*line][move.player]-- == 3) --completedLines[move.player];
+  hash ^= kZobrist.keys[move.cell][move.player];
+  currentPlayer = move.playerBefore;
+}
+
+bool TicTacToeGame::undoMove() {
+  if (moveCount == 0) return false;
+  MoveRecord move = moveStack[moveCount - 1];
+  move.playerAfter = currentPlayer;
+  undoLastMove();
+  redoStack[redoCount++] = move;
   return true;
 }
 
-bool TicTacToeGame::checkWin(Player player) const {
-  // Check rows and columns
-  for (int i = 0; i < 3; ++i) {
-    if (board[i][0] == player && board[i][1] == player && board[i][2] == player)
-      return true;
-    if (board[0][i] == player && board[1][i] == player && board[2][i] == player)
-      return true;
-  }
+bool TicTacToeGame::redoMove() {
+  if (redoCount == 0) return false;
+  const MoveRecord move = redoStack[--redoCount];
+  doMove(move.cell, move.player);
+  currentPlayer = move.playerAfter;
+  return true;
+}
 
-  // Check diagonals
-  if (board[0][0] == player && board[1][1] == player && board[2][2] == player)
-    return true;
-  if (board[0][2] == player && board[1][1] == player && board[2][0] == player)
-    return true;
-  return false;
+bool TicTacToeGame::isBoardFull() const { return moveCount == 9; }
+
+bool TicTacToeGame::checkWin(Player player) const {
+  return player != NONE && completedLines[player] > 0;
 }
 
 Player TicTacToeGame::getCell(int row, int col) const {
@@ -58,65 +124,34 @@ void TicTacToeGame::switchPlayer() {
   currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
 }
 
-std::pair<int, int> TicTacToeGame::getAIMove() {
-  switch (difficultyLevel) {
-    case 1:
-      return easyAI();
+void TicTacToeGame::setDifficulty(int level) {
+  difficultyLevel = level;
+  switch (level) {
     case 2:
-      return mediumAI();
+      setStrength(0.5);
+      break;
     case 3:
-      return getBestMove(AI);
+      setStrength(1.0);
+      break;
     default:
-      return easyAI();
+      setStrength(0.0);
+      break;
   }
 }
 
-std::pair<int, int> TicTacToeGame::easyAI() {
-  std::vector<std::pair<int, int>> emptyCells;
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      if (board[i][j] == NONE) emptyCells.push_back(std::make_pair(i, j));
-
-  if (!emptyCells.empty()) {
-    int randomIndex = std::rand() % emptyCells.size();
-    return emptyCells[randomIndex];
-  }
-  return std::make_pair(-1, -1);
+void TicTacToeGame::setStrength(double value) {
+  strength = std::min(1.0, std::max(0.0, value));
 }
 
-std::pair<int, int> TicTacToeGame::mediumAI() {
-  // First check if AI can win
-  for (int i = 0; i < 3; ++i) {
-    for (int j = 0; j < 3; ++j) {
-      if (board[i][j] == NONE) {
-        board[i][j] = AI;
-        if (checkWin(AI)) {
-          board[i][j] = NONE;
-          return std::make_pair(i, j);
-        }
-        board[i][j] = NONE;
-      }
-    }
-  }
-
-  // Then check if need to block human
-  for (int i = 0; i < 3; ++i) {
-    for (int j = 0; j < 3; ++j) {
-      if (board[i][j] == NONE) {
-        board[i][j] = HUMAN;
-        if (checkWin(HUMAN)) {
-          board[i][j] = NONE;
-          return std::make_pair(i, j);
-        }
-        board[i][j] = NONE;
-      }
-    }
-  }
-
-  // Otherwise random move
-  return easyAI();
+long TicTacToeGame::nodeBudgetForStrength(double value) {
+  value = std::min(1.0, std::max(0.0, value));
+  // Geometric interpolation so each step up costs a constant factor more
+  return static_cast<long>(
+      std::lround(kMinNodes * std::pow(double(kMaxNodes) / kMinNodes, value)));
 }
 
+std::pair<int, int> TicTacToeGame::getAIMove() { return budgetedSearch(AI); }
+
 std::pair<int, int> TicTacToeGame::getBestMove(Player aiPlayer) {
   int bestScore = INT_MIN;
   std::pair<int, int> bestMove = std::make_pair(-1, -1);
@@ -125,9 +160,9 @@ std::pair<int, int> TicTacToeGame::getBestMove(Player aiPlayer) {
   for (int i = 0; i < 3; ++i) {
     for (int j = 0; j < 3; ++j) {
       if (board[i][j] == NONE) {
-        board[i][j] = aiPlayer;
+        doMove(i * 3 + j, aiPlayer);
         int score = minimax(0, false, INT_MIN, INT_MAX, aiPlayer, humanPlayer);
-        board[i][j] = NONE;
+        undoLastMove();
         if (score > bestScore) {
           bestScore = score;
           bestMove = std::make_pair(i, j);
@@ -159,10 +194,10 @@ int TicTacToeGame::minimax(int depth, bool isMaximizing, int alpha, int beta,
     for (int i = 0; i < 3; ++i) {
       for (int j = 0; j < 3; ++j) {
         if (board[i][j] == NONE) {
-          board[i][j] = aiPlayer;
+          doMove(i * 3 + j, aiPlayer);
           int eval =
               minimax(depth + 1, false, alpha, beta, aiPlayer, humanPlayer);
-          board[i][j] = NONE;
+          undoLastMove();
 
           maxEval = std::max(maxEval, eval);
           alpha = std::max(alpha, eval);
@@ -181,10 +216,10 @@ int TicTacToeGame::minimax(int depth, bool isMaximizing, int alpha, int beta,
     for (int i = 0; i < 3; ++i) {
       for (int j = 0; j < 3; ++j) {
         if (board[i][j] == NONE) {
-          board[i][j] = humanPlayer;
+          doMove(i * 3 + j, humanPlayer);
           int eval =
               minimax(depth + 1, true, alpha, beta, aiPlayer, humanPlayer);
-          board[i][j] = NONE;
+          undoLastMove();
 
           minEval = std::min(minEval, eval);
           beta = std::min(beta, eval);
@@ -199,3 +234,117 @@ int TicTacToeGame::minimax(int depth, bool isMaximizing, int alpha, int beta,
     return minEval;
   }
 }
+
+std::pair<int, int> TicTacToeGame::budgetedSearch(Player aiPlayer) {
+  SearchTask task(*this, aiPlayer);
+  task.step(LONG_MAX);
+  searchNodes = task.getNodes();
+  return task.getMove();
+}
+
+int TicTacToeGame::solvePosition(Player toMove, int* bestCell) {
+  Player opponent = (toMove == HUMAN) ? AI : HUMAN;
+  if (bestCell) *bestCell = -1;
+  if (checkWin(toMove)) return kWinScore;
+  if (checkWin(opponent)) return -kWinScore;
+  if (isBoardFull()) return 0;
+
+  // Searching to the end of the game never reaches a heuristic leaf, so
+  // every score is exact
+  SearchTask task(*this, toMove, true);
+  task.step(LONG_MAX);
+  searchNodes = task.getNodes();
+  if (bestCell) {
+    std::pair<int, int> move = task.getMove();
+    *bestCell = move.first * 3 + move.second;
+  }
+  return task.getScore();
+}
+
+std::vector<SearchLine> TicTacToeGame::analyzePosition(Player toMove,
+                                                       int lineCount) {
+  SearchTask task(*this, toMove, true);
+  task.setMultiPV(lineCount);
+  task.step(LONG_MAX);
+  searchNodes = task.getNodes();
+  return task.getLines();
+}
+
+void TicTacToeGame::setTranspositionTable(TranspositionTable* value) {
+  table = value;
+  ownTable.reset();
+  useOwnTable = false;
+}
+
+void TicTacToeGame::prepareTable() {
+  if (!useOwnTable || ownTable) return;
+  ownTable = std::make_shared<TranspositionTable>(kOwnTableSlots);
+  table = ownTable.get();
+}
+
+void TicTacToeGame::setEvaluator(Evaluator* value) {
+  evaluator = value ? value : &defaultEvaluator;
+}
+
+void TicTacToeGame::fillEvalPosition(Player toMove,
+                                     EvalPosition& position) const {
+  for (int cell = 0; cell < 9; ++cell) {
+    int value = board[cell / 3][cell % 3];
+    position.cells[cell] = value == NONE ? 0 : (value == toMove ? 1 : -1);
+  }
+}
+
+int TicTacToeGame::heuristicScore(Player toMove) {
+  EvalPosition position;
+  fillEvalPosition(toMove, position);
+  int score = 0;
+  evaluator->evaluateBatch(&position, 1, &score);
+  return score;
+}
+
+int TicTacToeGame::evaluateFrontier(int ply, Player toMove, Player opponent,
+                                    int& bestCell) {
+  // All children are leaves: resolve terminal ones directly and send the
+  // rest to the evaluator in a single batch
+  EvalPosition batch[9];
+  int batchCells[9];
+  int scores[9];
+  int count = 0;
+  int best = -kWinScore - 1;
+  bestCell = -1;
+
+  for (int cell = 0; cell < 9; ++cell) {
+    if (board[cell / 3][cell % 3] != NONE) continue;
+    if (++searchNodes > nodeBudget) {
+      searchAborted = true;
+      return 0;
+    }
+
+    doMove(cell, toMove);
+    int score = best;
+    if (checkWin(toMove)) {
+      score = kWinScore - (ply + 1);
+    } else if (isBoardFull()) {
+      score = 0;
+    } else {
+      batchCells[count] = cell;
+      fillEvalPosition(opponent, batch[count++]);
+    }
+    undoLastMove();
+    if (score > best) {
+      best = score;
+      bestCell = cell;
+    }
+  }
+
+  if (count > 0) {
+    evaluator->evaluateBatch(batch, count, scores);
+    for (int i = 0; i < count; ++i) {
+      if (-scores[i] > best) {
+        best = -scores[i];
+        bestCell = batchCells[i];
+      }
+    }
+  }
+  return best;
+}
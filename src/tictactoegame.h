@@ -2,18 +2,63 @@
 #define TICTACTOEGAME_H
 #include <algorithm>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <random>
 #include <utility>
 #include <vector>
+
+#include "evaluator.h"
+#include "transpositiontable.h"
 enum Player { NONE = 0, HUMAN = 1, AI = 2 };
+
+// One entry of the reversible move stack
+struct MoveRecord {
+  int cell;               // row * 3 + col
+  Player player;          // who moved
+  Player playerBefore;    // currentPlayer before the move
+  Player playerAfter;     // currentPlayer when the move was undone (for redo)
+};
+
+// One line of a multi-PV analysis: the root move and the expected replies
+struct SearchLine {
+  int score;               // exact value for the side to move at the root
+  std::vector<int> moves;  // cells (row * 3 + col), root move first
+};
+
 class TicTacToeGame {
+  friend class SearchTask;
+
  private:
   int board[3][3];
+  // Incrementally maintained alongside board by doMove/undoLastMove
+  int lineCount[8][3];     // pieces per winning line, indexed by Player
+  int completedLines[3];   // lines fully owned, indexed by Player
+  uint64_t hash;           // Zobrist hash of the position
+  MoveRecord moveStack[9];
+  int moveCount;
+  MoveRecord redoStack[9];
+  int redoCount;
   int difficultyLevel;
+  double strength;  // 0.0 (weakest) .. 1.0 (perfect play)
   Player currentPlayer;
+  std::mt19937 rng;
+  long searchNodes;
+  long nodeBudget;
+  bool searchAborted;
+  TranspositionTable* table;  // nullptr disables caching
+  // Created on the first search unless setTranspositionTable was called;
+  // copies of the game share it
+  std::shared_ptr<TranspositionTable> ownTable;
+  bool useOwnTable;
+  Evaluator* evaluator;       // not owned
   bool gameMode;  // true for PvP, false for PvAI
  public:
+  // Search scores: wins are kWinScore - ply, heuristic leaves stay well below
+  static const int kWinScore = 1000;
+
   TicTacToeGame();
   void resetGame();
   bool makeMove(int row, int col, Player player);
@@ -23,9 +68,17 @@ class TicTacToeGame {
   Player getCurrentPlayer() const { return currentPlayer; }
   void switchPlayer();
 
+  // Move stack: O(1) takeback restoring board, hash, line counters and
+  // current player. Making a new move discards the redo history.
+  bool undoMove();
+  bool redoMove();
+  bool canUndo() const { return moveCount > 0; }
+  bool canRedo() const { return redoCount > 0; }
+  int getMoveCount() const { return moveCount; }
+  const MoveRecord& getMove(int index) const { return moveStack[index]; }
+  uint64_t getHash() const { return hash; }
+
  public:
-  std::pair<int, int> test_easyAI() { return easyAI(); }
-  std::pair<int, int> test_mediumAI() { return mediumAI(); }
   std::pair<int, int> test_getBestMove(Player aiPlayer) {
     return getBestMove(aiPlayer);
   }
@@ -40,16 +93,52 @@ class TicTacToeGame {
   }
 
   // AI methods
-  void setDifficulty(int level) { difficultyLevel = level; }
+  void setDifficulty(int level);
   void setGameMode(bool pvp) { gameMode = pvp; }
   std::pair<int, int> getAIMove();
 
+  // Continuous strength: scales the search node budget and the noise added
+  // to root move scores. The three difficulty tiers map onto 0.0, 0.5, 1.0.
+  void setStrength(double value);
+  double getStrength() const { return strength; }
+  void setSeed(unsigned int seed) { rng.seed(seed); }
+  long getLastSearchNodes() const { return searchNodes; }
+  static long nodeBudgetForStrength(double value);
+  // By default each game caches in a table of its own, so a seeded game's
+  // moves depend only on its own history. Pass &TranspositionTable::shared()
+  // to share entries across games, or nullptr to disable caching.
+  void setTranspositionTable(TranspositionTable* value);
+  // Leaf evaluator for the budgeted search; nullptr restores the default
+  // LineEvaluator. The game does not take ownership.
+  void setEvaluator(Evaluator* value);
+
+  // Exact value of the position for toMove: 1000 - plies for a forced win,
+  // -(1000 - plies) for a forced loss, 0 for a draw. bestCell receives the
+  // cell (row * 3 + col) of an optimal move, or -1 if the game is over.
+  int solvePosition(Player toMove, int* bestCell = nullptr);
+  // The best lineCount moves for toMove with their principal variations,
+  // best first, from a single exact search
+  std::vector<SearchLine> analyzePosition(Player toMove, int lineCount);
+
  private:
-  std::pair<int, int> easyAI();
-  std::pair<int, int> mediumAI();
   std::pair<int, int> getBestMove(Player aiPlayer);
   int minimax(int depth, bool isMaximizing, int alpha, int beta,
               Player aiPlayer, Player humanPlayer);
   int evaluateBoard(Player aiPlayer, Player humanPlayer);
+
+  // Node-budgeted iterative deepening search used by getAIMove; the search
+  // itself is a SearchTask run to completion
+  std::pair<int, int> budgetedSearch(Player aiPlayer);
+  int heuristicScore(Player toMove);
+  int evaluateFrontier(int ply, Player toMove, Player opponent,
+                       int& bestCell);
+  void fillEvalPosition(Player toMove, EvalPosition& position) const;
+
+  // Creates the game's own table if it uses one and has none yet
+  void prepareTable();
+
+  // Reversible make/unmake shared by the public move API and the search
+  void doMove(int cell, Player player);
+  void undoLastMove();
 };
 #endif  // TICTACTOEGAME_H
@@ -0,0 +1,252 @@
+#include "trainingexport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "tictactoegame.h"
+
+namespace {
+const char kMagic[4] = {'T', 'T', 'T', 'D'};
+
+// Source cell for each destination cell under the 8 symmetries of the square
+const int kSymmetries[8][9] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8}, {6, 3, 0, 7, 4, 1, 8, 5, 2},
+    {8, 7, 6, 5, 4, 3, 2, 1, 0}, {2, 5, 8, 1, 4, 7, 0, 3, 6},
+    {2, 1, 0, 5, 4, 3, 8, 7, 6}, {6, 7, 8, 3, 4, 5, 0, 1, 2},
+    {0, 3, 6, 1, 4, 7, 2, 5, 8}, {8, 5, 2, 7, 4, 1, 6, 3, 0}};
+
+void putLE(unsigned char* out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) out[i] = (value >> (8 * i)) & 0xFF;
+}
+
+uint64_t getLE(const unsigned char* in, int bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i) value |= uint64_t(in[i]) << (8 * i);
+  return value;
+}
+
+// Bounded multi-producer, single-consumer queue of record batches
+class BatchQueue {
+ public:
+  explicit BatchQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+  void push(std::vector<TrainingRecord>&& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this]() { return batches.size() < capacity; });
+    batches.push_back(std::move(batch));
+    notEmpty.notify_one();
+  }
+
+  bool pop(std::vector<TrainingRecord>& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]() { return !batches.empty() || closed; });
+    if (batches.empty()) return false;
+    batch = std::move(batches.front());
+    batches.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_all();
+  }
+
+ private:
+  size_t capacity;
+  bool closed;
+  std::deque<std::vector<TrainingRecord>> batches;
+  std::mutex mutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+};
+}  // namespace
+
+void TrainingExporter::encodeRecord(const TrainingRecord& record,
+                                    unsigned char* out) {
+  putLE(out + 0, record.board, 2);
+  out[2] = record.sideToMove;
+  out[3] = record.bestMove;
+  putLE(out + 4, uint16_t(record.value), 2);
+  out[6] = uint8_t(record.result);
+  out[7] = record.ply;
+  putLE(out + 8, record.gameId, 4);
+  putLE(out + 12, 0, 4);  // reserved
+}
+
+TrainingRecord TrainingExporter::decodeRecord(const unsigned char* in) {
+  TrainingRecord record;
+  record.board = uint16_t(getLE(in + 0, 2));
+  record.sideToMove = in[2];
+  record.bestMove = in[3];
+  record.value = int16_t(uint16_t(getLE(in + 4, 2)));
+  record.result = int8_t(in[6]);
+  record.ply = in[7];
+  record.gameId = uint32_t(getLE(in + 8, 4));
+  return record;
+}
+
+uint16_t TrainingExporter::canonicalize(const int cells[9], int move,
+                                        int* canonicalMove) {
+  uint16_t best = 0xFFFF;
+  for (const auto& symmetry : kSymmetries) {
+    uint16_t code = 0;
+    for (int dst = 8; dst >= 0; --dst) code = code * 3 + cells[symmetry[dst]];
+    if (code < best) {
+      best = code;
+      if (canonicalMove) {
+        *canonicalMove = move;
+        for (int dst = 0; dst < 9; ++dst)
+          if (symmetry[dst] == move) *canonicalMove = dst;
+      }
+    }
+  }
+  return best;
+}
+
+bool TrainingExporter::readFile(const std::string& path,
+                                std::vector<TrainingRecord>& records) {
+  FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) return false;
+
+  unsigned char header[kHeaderSize];
+  bool ok = std::fread(header, 1, kHeaderSize, file) == kHeaderSize &&
+            std::memcmp(header, kMagic, 4) == 0 &&
+            getLE(header + 4, 4) == kFormatVersion &&
+            getLE(header + 8, 4) == kRecordSize;
+
+  unsigned char buffer[kRecordSize];
+  while (ok && std::fread(buffer, 1, kRecordSize, file) == kRecordSize)
+    records.push_back(decodeRecord(buffer));
+
+  std::fclose(file);
+  return ok;
+}
+
+bool TrainingExporter::run(const std::string& path, const Options& options) {
+  recordsWritten = 0;
+  gamesPlayed = 0;
+
+  FILE* file = std::fopen(path.c_str(), "ab");
+  if (!file) return false;
+
+  // Append-only: the header is written once, when the file is new
+  std::fseek(file, 0, SEEK_END);
+  if (std::ftell(file) == 0) {
+    unsigned char header[kHeaderSize] = {0};
+    std::memcpy(header, kMagic, 4);
+    putLE(header + 4, kFormatVersion, 4);
+    putLE(header + 8, kRecordSize, 4);
+    if (std::fwrite(header, 1, kHeaderSize, file) != kHeaderSize) {
+      std::fclose(file);
+      return false;
+    }
+  }
+
+  int threadCount = options.threads > 0
+                        ? options.threads
+                        : int(std::max(1u, std::thread::hardware_concurrency()));
+  BatchQueue queue(std::max<size_t>(1, options.queueBatches));
+  std::atomic<long> nextGame(0);
+  std::atomic<long> finishedGames(0);
+
+  auto worker = [&]() {
+    // Each worker owns its engine; the shared search table is thread-safe
+    TicTacToeGame game;
+    game.setTranspositionTable(&TranspositionTable::shared());
+    std::vector<TrainingRecord> batch;
+    batch.reserve(options.batchRecords);
+
+    for (long id = nextGame++; id < options.games; id = nextGame++) {
+      std::mt19937 rng(options.seed + static_cast<unsigned int>(id));
+      std::uniform_real_distribution<double> coin(0.0, 1.0);
+      game.resetGame();
+
+      size_t gameStart = batch.size();
+      Player toMove = HUMAN;
+      while (!game.checkWin(HUMAN) && !game.checkWin(AI) &&
+             !game.isBoardFull()) {
+        int cells[9];
+        for (int i = 0; i < 9; ++i) cells[i] = game.getCell(i / 3, i % 3);
+
+        int bestCell = -1;
+        int value = game.solvePosition(toMove, &bestCell);
+
+        TrainingRecord record;
+        int canonicalMove = bestCell;
+        record.board = canonicalize(cells, bestCell, &canonicalMove);
+        record.sideToMove = uint8_t(toMove);
+        record.bestMove = uint8_t(canonicalMove);
+        record.value = int16_t(value);
+        record.result = 0;
+        record.ply = uint8_t(game.getMoveCount());
+        record.gameId = uint32_t(id);
+        batch.push_back(record);
+
+        int move = bestCell;
+        if (coin(rng) < options.exploration) {
+          std::vector<int> empty;
+          for (int i = 0; i < 9; ++i)
+            if (cells[i] == NONE) empty.push_back(i);
+          move = empty[std::uniform_int_distribution<int>(
+              0, int(empty.size()) - 1)(rng)];
+        }
+        game.makeMove(move / 3, move % 3, toMove);
+        toMove = (toMove == HUMAN) ? AI : HUMAN;
+      }
+
+      // Fill in the outcome now that the game is over
+      Player winner = game.checkWin(HUMAN) ? HUMAN
+                      : game.checkWin(AI)  ? AI
+                                           : NONE;
+      for (size_t i = gameStart; i < batch.size(); ++i) {
+        if (winner != NONE)
+          batch[i].result = batch[i].sideToMove == winner ? 1 : -1;
+      }
+      ++finishedGames;
+
+      if (batch.size() >= options.batchRecords) {
+        queue.push(std::move(batch));
+        batch = std::vector<TrainingRecord>();
+        batch.reserve(options.batchRecords);
+      }
+    }
+    if (!batch.empty()) queue.push(std::move(batch));
+  };
+
+  // Single writer keeps the file strictly append-only and unfragmented
+  bool writeOk = true;
+  long written = 0;
+  std::thread writer([&]() {
+    std::vector<TrainingRecord> batch;
+    std::vector<unsigned char> buffer;
+    while (queue.pop(batch)) {
+      buffer.resize(batch.size() * kRecordSize);
+      for (size_t i = 0; i < batch.size(); ++i)
+        encodeRecord(batch[i], &buffer[i * kRecordSize]);
+      if (writeOk &&
+          std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+        writeOk = false;
+      written += long(batch.size());
+    }
+  });
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threadCount; ++i) workers.emplace_back(worker);
+  for (std::thread& thread : workers) thread.join();
+  queue.close();
+  writer.join();
+
+  writeOk = (std::fclose(file) == 0) && writeOk;
+  recordsWritten = written;
+  gamesPlayed = finishedGames;
+  return writeOk;
+}
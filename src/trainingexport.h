@@ -0,0 +1,57 @@
+#ifndef TRAININGEXPORT_H
+#define TRAININGEXPORT_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One self-play position, stored in the canonical symmetry frame
+struct TrainingRecord {
+  uint16_t board;      // base-3 cells (0 empty, 1 X, 2 O), canonical frame
+  uint8_t sideToMove;  // 1 X, 2 O
+  uint8_t bestMove;    // canonical cell index 0..8
+  int16_t value;       // exact search value for the side to move
+  int8_t result;       // final game result for the side to move: 1, 0, -1
+  uint8_t ply;
+  uint32_t gameId;
+};
+
+// Self-play training data in an append-only binary file: a 16-byte header
+// ("TTTD", format version, record size) followed by fixed-width 16-byte
+// little-endian records. Worker threads play and solve games while a
+// single writer streams batches to disk through a bounded queue, so memory
+// stays constant no matter how many games are generated.
+class TrainingExporter {
+ public:
+  static const uint32_t kFormatVersion = 1;
+  static const size_t kRecordSize = 16;
+  static const size_t kHeaderSize = 16;
+
+  struct Options {
+    int threads = 0;            // 0 = hardware concurrency
+    long games = 1000;
+    unsigned int seed = 1;
+    double exploration = 0.3;   // chance of a random instead of best move
+    size_t queueBatches = 64;   // bounds memory held between threads
+    size_t batchRecords = 4096;
+  };
+
+  bool run(const std::string& path, const Options& options);
+  long getRecordsWritten() const { return recordsWritten; }
+  long getGamesPlayed() const { return gamesPlayed; }
+
+  static void encodeRecord(const TrainingRecord& record, unsigned char* out);
+  static TrainingRecord decodeRecord(const unsigned char* in);
+  static bool readFile(const std::string& path,
+                       std::vector<TrainingRecord>& records);
+
+  // Smallest base-3 encoding over the 8 board symmetries; canonicalMove
+  // receives move mapped into the same frame
+  static uint16_t canonicalize(const int cells[9], int move,
+                               int* canonicalMove);
+
+ private:
+  long recordsWritten = 0;
+  long gamesPlayed = 0;
+};
+#endif  // TRAININGEXPORT_H
@@ -0,0 +1,101 @@
+#include "transpositiontable.h"
+
+namespace {
+// Data word layout
+const int kScoreShift = 0;    // 16 bits, two's complement
+const int kDepthShift = 16;   // 8 bits
+const int kBoundShift = 24;   // 2 bits
+const int kMoveShift = 26;    // 8 bits, bestMove + 1 (0 = none)
+const int kAgeShift = 34;     // 8 bits
+const int kAgeWeight = 4;     // one generation counts as this many plies
+
+inline uint32_t field(uint64_t data, int shift) {
+  return static_cast<uint32_t>((data >> shift) & 0xFF);
+}
+}  // namespace
+
+TranspositionTable::TranspositionTable(size_t slots)
+    : slotCount(0), bucketMask(0), generation(0) {
+  resize(slots);
+}
+
+TranspositionTable& TranspositionTable::shared() {
+  static TranspositionTable table;
+  return table;
+}
+
+void TranspositionTable::resize(size_t requested) {
+  // Round the bucket count down to a power of two for mask indexing
+  size_t buckets = 1;
+  while (buckets * 2 * kBucketSize <= requested) buckets *= 2;
+  slotCount = buckets * kBucketSize;
+  bucketMask = buckets - 1;
+  slots.reset(new Slot[slotCount]);
+  clear();
+}
+
+void TranspositionTable::clear() {
+  for (size_t i = 0; i < slotCount; ++i) {
+    slots[i].check.store(0, std::memory_order_relaxed);
+    slots[i].data.store(0, std::memory_order_relaxed);
+  }
+  generation.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(int score, int depth, TTBound bound,
+                                  int bestMove, uint32_t age) {
+  return (uint64_t(uint16_t(int16_t(score))) << kScoreShift) |
+         (uint64_t(depth & 0xFF) << kDepthShift) |
+         (uint64_t(bound & 0x3) << kBoundShift) |
+         (uint64_t((bestMove + 1) & 0xFF) << kMoveShift) |
+         (uint64_t(age & 0xFF) << kAgeShift);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+  const Slot* bucket = &slots[(key & bucketMask) * kBucketSize];
+  for (size_t i = 0; i < kBucketSize; ++i) {
+    uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+    uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || data == 0) continue;
+
+    entry.score = int16_t(uint16_t(data >> kScoreShift));
+    entry.depth = int(field(data, kDepthShift));
+    entry.bound = static_cast<TTBound>((data >> kBoundShift) & 0x3);
+    entry.bestMove = int(field(data, kMoveShift)) - 1;
+    return true;
+  }
+  return false;
+}
+
+void TranspositionTable::store(uint64_t key, int score, int depth,
+                               TTBound bound, int bestMove) {
+  uint32_t age = generation.load(std::memory_order_relaxed) & 0xFF;
+  Slot* bucket = &slots[(key & bucketMask) * kBucketSize];
+
+  // Same key first, otherwise the slot with the lowest depth after ageing
+  Slot* victim = &bucket[0];
+  int victimWorth = 1 << 30;
+  for (size_t i = 0; i < kBucketSize; ++i) {
+    uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+    uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+    if ((check ^ data) == key) {
+      // Keep a deeper result from the current search for the same position
+      if (field(data, kAgeShift) == age &&
+          int(field(data, kDepthShift)) > depth && bound != TT_EXACT)
+        return;
+      victim = &bucket[i];
+      break;
+    }
+    int staleness = int((age - field(data, kAgeShift)) & 0xFF);
+    int worth = data == 0 ? -1 : int(field(data, kDepthShift)) -
+                                     kAgeWeight * staleness;
+    if (worth < victimWorth) {
+      victimWorth = worth;
+      victim = &bucket[i];
+    }
+  }
+
+  uint64_t data = pack(score, depth, bound, bestMove, age);
+  victim->data.store(data, std::memory_order_relaxed);
+  victim->check.store(key ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum TTBound { TT_EXACT = 0, TT_LOWER = 1, TT_UPPER = 2 };
+
+struct TTEntry {
+  int score;
+  int depth;
+  TTBound bound;
+  int bestMove;  // -1 if none
+};
+
+// Lock-free transposition table, safe to share between concurrent searches.
+// Each slot is two 64-bit words: the packed data and the key XORed with the
+// data. Readers accept a slot only if the XOR of the two words reproduces
+// their key, so a slot torn by a concurrent writer is rejected instead of
+// returning mixed data. Slots are grouped in buckets of four; a store
+// replaces the shallowest entry, treating entries from older searches as
+// shallower.
+class TranspositionTable {
+ public:
+  static const size_t kBucketSize = 4;
+
+  explicit TranspositionTable(size_t slotCount = 1 << 18);
+
+  // Process-wide table; the game engines use it only when asked to
+  static TranspositionTable& shared();
+
+  bool probe(uint64_t key, TTEntry& entry) const;
+  void store(uint64_t key, int score, int depth, TTBound bound, int bestMove);
+
+  // Start a new search generation; ages every existing entry by one
+  void newSearch() { generation.fetch_add(1, std::memory_order_relaxed); }
+
+  // Not thread-safe: call only while no search is running
+  void clear();
+  void resize(size_t slotCount);
+  size_t size() const { return slotCount; }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> check;  // key ^ data
+    std::atomic<uint64_t> data;
+  };
+
+  std::unique_ptr<Slot[]> slots;
+  size_t slotCount;
+  size_t bucketMask;
+  std::atomic<uint32_t> generation;
+
+  static uint64_t pack(int score, int depth, TTBound bound, int bestMove,
+                       uint32_t age);
+};
+#endif  // TRANSPOSITIONTABLE_H
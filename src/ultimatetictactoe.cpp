@@ -0,0 +1,239 @@
+#include "ultimatetictactoe.h"
+
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+namespace {
+const uint16_t kFullBoard = 0x1FF;
+const uint16_t kLineMasks[8] = {0x007, 0x038, 0x1C0, 0x049,
+                                0x092, 0x124, 0x111, 0x054};
+
+// hasLine lookup for every 9-bit occupancy mask
+struct LineTable {
+  bool hasLine[512];
+  LineTable() {
+    for (int mask = 0; mask < 512; ++mask) {
+      hasLine[mask] = false;
+      for (uint16_t line : kLineMasks)
+        if ((mask & line) == line) hasLine[mask] = true;
+    }
+  }
+};
+const LineTable kLineTable;
+
+inline int playerIndex(Player player) { return player == HUMAN ? 0 : 1; }
+
+struct Node {
+  int parent;
+  int firstChild;
+  int childCount;
+  uint8_t move;
+  int visits;
+  double wins;  // from the perspective of the player who made `move`
+};
+}  // namespace
+
+UltimateTicTacToe::UltimateTicTacToe()
+    : rng(static_cast<unsigned int>(std::time(0))), lastIterations(0) {
+  resetGame();
+}
+
+void UltimateTicTacToe::resetGame() { position.reset(); }
+
+void UltimateTicTacToe::Position::reset() {
+  for (int p = 0; p < 2; ++p) {
+    for (int b = 0; b < 9; ++b) stones[p][b] = 0;
+    wonBoards[p] = 0;
+  }
+  closedBoards = 0;
+  activeBoard = kAnyBoard;
+  currentPlayer = HUMAN;
+  winner = NONE;
+  gameOver = false;
+}
+
+bool UltimateTicTacToe::hasLine(uint16_t mask) {
+  return kLineTable.hasLine[mask & kFullBoard];
+}
+
+bool UltimateTicTacToe::isLegalMove(int board, int cell) const {
+  const Position& p = position;
+  if (p.gameOver || board < 0 || board > 8 || cell < 0 || cell > 8)
+    return false;
+  if (p.activeBoard != kAnyBoard && board != p.activeBoard) return false;
+  if (p.closedBoards & (1 << board)) return false;
+  return !((p.stones[0][board] | p.stones[1][board]) & (1 << cell));
+}
+
+bool UltimateTicTacToe::makeMove(int board, int cell) {
+  if (!isLegalMove(board, cell)) return false;
+  position.applyMove(board, cell);
+  return true;
+}
+
+void UltimateTicTacToe::Position::applyMove(int board, int cell) {
+  int p = playerIndex(currentPlayer);
+  uint16_t& own = stones[p][board];
+  own |= 1 << cell;
+
+  if (hasLine(own)) {
+    wonBoards[p] |= 1 << board;
+    closedBoards |= 1 << board;
+    if (hasLine(wonBoards[p])) {
+      winner = currentPlayer;
+      gameOver = true;
+    }
+  } else if ((own | stones[1 - p][board]) == kFullBoard) {
+    closedBoards |= 1 << board;
+  }
+
+  if (!gameOver && closedBoards == kFullBoard) gameOver = true;  // draw
+
+  activeBoard = (closedBoards & (1 << cell)) ? kAnyBoard : cell;
+  currentPlayer = (currentPlayer == HUMAN) ? AI : HUMAN;
+}
+
+int UltimateTicTacToe::generateMoves(uint8_t* moves) const {
+  return position.generateMoves(moves);
+}
+
+int UltimateTicTacToe::Position::generateMoves(uint8_t* moves) const {
+  if (gameOver) return 0;
+  int count = 0;
+  int first = (activeBoard == kAnyBoard) ? 0 : activeBoard;
+  int last = (activeBoard == kAnyBoard) ? 8 : activeBoard;
+  for (int b = first; b <= last; ++b) {
+    if (closedBoards & (1 << b)) continue;
+    uint16_t empty = ~(stones[0][b] | stones[1][b]) & kFullBoard;
+    while (empty) {
+      int cell = __builtin_ctz(empty);
+      empty &= empty - 1;
+      moves[count++] = static_cast<uint8_t>(b * 9 + cell);
+    }
+  }
+  return count;
+}
+
+Player UltimateTicTacToe::getCell(int board, int cell) const {
+  if (board < 0 || board > 8 || cell < 0 || cell > 8) return NONE;
+  if (position.stones[0][board] & (1 << cell)) return HUMAN;
+  if (position.stones[1][board] & (1 << cell)) return AI;
+  return NONE;
+}
+
+Player UltimateTicTacToe::getBoardWinner(int board) const {
+  if (board < 0 || board > 8) return NONE;
+  if (position.wonBoards[0] & (1 << board)) return HUMAN;
+  if (position.wonBoards[1] & (1 << board)) return AI;
+  return NONE;
+}
+
+Player UltimateTicTacToe::Position::playout(std::mt19937& gen) {
+  uint8_t moves[kMaxMoves];
+  while (!gameOver) {
+    int count = generateMoves(moves);
+    if (count == 0) break;  // unreachable: no moves implies gameOver
+    uint8_t move = moves[std::uniform_int_distribution<int>(0, count - 1)(gen)];
+    applyMove(move / 9, move % 9);
+  }
+  return winner;
+}
+
+std::pair<int, int> UltimateTicTacToe::getAIMove(int timeBudgetMs,
+                                                 long maxIterations) {
+  lastIterations = 0;
+  uint8_t rootMoves[kMaxMoves];
+  int rootCount = position.generateMoves(rootMoves);
+  if (rootCount == 0) return std::make_pair(-1, -1);
+
+  // Take an immediate game win without searching
+  for (int i = 0; i < rootCount; ++i) {
+    Position child = position;
+    child.applyMove(rootMoves[i] / 9, rootMoves[i] % 9);
+    if (child.winner == position.currentPlayer)
+      return std::make_pair(rootMoves[i] / 9, rootMoves[i] % 9);
+  }
+
+  const double kExploration = 1.41421356;
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeBudgetMs);
+
+  std::vector<Node> tree;
+  tree.reserve(1 << 16);
+  tree.push_back({-1, -1, 0, 0, 0, 0.0});
+
+  uint8_t moves[kMaxMoves];
+  while (lastIterations < maxIterations) {
+    // Checking the clock every iteration would dominate short playouts
+    if ((lastIterations & 63) == 0 && lastIterations > 0 &&
+        std::chrono::steady_clock::now() >= deadline)
+      break;
+    ++lastIterations;
+
+    // Selection
+    Position state = position;
+    int node = 0;
+    while (tree[node].childCount > 0) {
+      const Node& parent = tree[node];
+      double logVisits = std::log(double(parent.visits));
+      int best = parent.firstChild;
+      double bestValue = -1.0;
+      for (int c = parent.firstChild; c < parent.firstChild + parent.childCount;
+           ++c) {
+        const Node& child = tree[c];
+        if (child.visits == 0) {
+          best = c;
+          break;
+        }
+        double value = child.wins / child.visits +
+                       kExploration * std::sqrt(logVisits / child.visits);
+        if (value > bestValue) {
+          bestValue = value;
+          best = c;
+        }
+      }
+      node = best;
+      state.applyMove(tree[node].move / 9, tree[node].move % 9);
+    }
+
+    // Expansion
+    if (!state.gameOver && tree[node].visits > 0) {
+      int count = state.generateMoves(moves);
+      int first = static_cast<int>(tree.size());
+      for (int i = 0; i < count; ++i)
+        tree.push_back({node, -1, 0, moves[i], 0, 0.0});
+      tree[node].firstChild = first;
+      tree[node].childCount = count;
+      if (count > 0) {
+        node = first;
+        state.applyMove(tree[node].move / 9, tree[node].move % 9);
+      }
+    }
+
+    // Simulation: mover of the leaf is the player who is not to move
+    Player leafMover = (state.currentPlayer == HUMAN) ? AI : HUMAN;
+    Player result = state.playout(rng);
+
+    // Backpropagation, flipping perspective at each ply
+    Player mover = leafMover;
+    for (int n = node; n >= 0; n = tree[n].parent) {
+      tree[n].visits++;
+      if (result == mover)
+        tree[n].wins += 1.0;
+      else if (result == NONE)
+        tree[n].wins += 0.5;
+      mover = (mover == HUMAN) ? AI : HUMAN;
+    }
+  }
+
+  // Most visited root child is the most robust choice
+  const Node& root = tree[0];
+  if (root.childCount == 0) {
+    return std::make_pair(rootMoves[0] / 9, rootMoves[0] % 9);
+  }
+  int best = root.firstChild;
+  for (int c = root.firstChild; c < root.firstChild + root.childCount; ++c)
+    if (tree[c].visits > tree[best].visits) best = c;
+  return std::make_pair(tree[best].move / 9, tree[best].move % 9);
+}
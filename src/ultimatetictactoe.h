@@ -0,0 +1,66 @@
+#ifndef ULTIMATETICTACTOE_H
+#define ULTIMATETICTACTOE_H
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "tictactoegame.h"  // Player
+
+// Ultimate Tic-Tac-Toe: a 3x3 meta-board of 3x3 sub-boards. The cell played
+// inside a sub-board selects the sub-board the opponent must play in next;
+// if that board is already decided the opponent may play in any open board.
+//
+// Each player's stones are nine 9-bit sub-board masks plus a 9-bit mask of
+// won sub-boards. The position is a small POD of its own that search
+// copies instead of undoing moves; the RNG and search counters stay
+// outside it.
+class UltimateTicTacToe {
+ public:
+  static constexpr int kAnyBoard = -1;
+  static constexpr int kMaxMoves = 81;
+
+  UltimateTicTacToe();
+  void resetGame();
+
+  // Moves are (board, cell) with both indices in 0..8, row-major
+  bool makeMove(int board, int cell);
+  bool isLegalMove(int board, int cell) const;
+  // Writes encoded moves (board * 9 + cell) and returns how many there are
+  int generateMoves(uint8_t* moves) const;
+
+  Player getCell(int board, int cell) const;
+  Player getBoardWinner(int board) const;
+  Player getWinner() const { return position.winner; }
+  bool isGameOver() const { return position.gameOver; }
+  Player getCurrentPlayer() const { return position.currentPlayer; }
+  int getActiveBoard() const { return position.activeBoard; }  // or kAnyBoard
+
+  // Monte Carlo tree search bounded by wall-clock time and iteration count
+  std::pair<int, int> getAIMove(int timeBudgetMs, long maxIterations = 1000000);
+  void setSeed(unsigned int seed) { rng.seed(seed); }
+  long getLastIterations() const { return lastIterations; }
+
+  static bool hasLine(uint16_t mask);
+
+ private:
+  struct Position {
+    uint16_t stones[2][9];  // per player, per sub-board occupancy
+    uint16_t wonBoards[2];  // per player, sub-boards won
+    uint16_t closedBoards;  // sub-boards won or full
+    int activeBoard;
+    Player currentPlayer;
+    Player winner;
+    bool gameOver;
+
+    void reset();
+    void applyMove(int board, int cell);
+    int generateMoves(uint8_t* moves) const;
+    Player playout(std::mt19937& gen);
+  };
+
+  Position position;
+  std::mt19937 rng;
+  long lastIterations;
+};
+#endif  // ULTIMATETICTACTOE_H
@@ -24,3 +24,43 @@ void User::addGameToHistory(const GameRecord& record) {
   gameHistory.prepend(record);
   // No longer limit to 5 games - let database handle the full history
 }
+
+QByteArray encodeMoves(const QVector<GameMove>& moves) {
+  if (moves.size() > 15) return QByteArray();
+
+  QByteArray data(2 + (moves.size() + 1) / 2, '\0');
+  int first = moves.isEmpty() ? 1 : moves[0].player;
+  data[0] = char(kMovesFormatVersion);
+  data[1] = char(moves.size() | (first == 2 ? 0x10 : 0));
+
+  for (int i = 0; i < moves.size(); ++i) {
+    const GameMove& move = moves[i];
+    int expected = (i % 2 == 0) ? first : 3 - first;
+    if (move.row < 0 || move.row > 2 || move.col < 0 || move.col > 2 ||
+        move.player != expected || (first != 1 && first != 2))
+      return QByteArray();
+    int cell = move.row * 3 + move.col;
+    data[2 + i / 2] = char(data[2 + i / 2] | (cell << (4 * (i % 2))));
+  }
+  return data;
+}
+
+bool decodeMoves(const QByteArray& data, QVector<GameMove>& moves) {
+  moves.clear();
+  if (data.size() < 2 || data[0] != char(kMovesFormatVersion)) return false;
+
+  int header = static_cast<unsigned char>(data[1]);
+  int count = header & 0x0F;
+  int player = (header & 0x10) ? 2 : 1;
+  if (data.size() != 2 + (count + 1) / 2) return false;
+
+  moves.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    int cell = (static_cast<unsigned char>(data[2 + i / 2]) >> (4 * (i % 2))) &
+               0x0F;
+    if (cell > 8) return false;
+    moves.append(GameMove(cell / 3, cell % 3, player));
+    player = 3 - player;
+  }
+  return true;
+}
@@ -1,6 +1,7 @@
 #ifndef USER_H
 #define USER_H
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QList>
 #include <QMetaType>
@@ -16,7 +17,19 @@ struct GameMove {
   GameMove(int r, int c, int p) : row(r), col(c), player(p) {}
 };
 
+// Compact binary move list, stored in game_history.moves_blob. Byte 0 is
+// the format version; version 1 follows with the move count (low nibble)
+// and first player (bit 4 set for O), then one 4-bit cell index per move,
+// two moves per byte, with players alternating. A full game takes 7 bytes.
+const int kMovesFormatVersion = 1;
+// Empty if the moves cannot be represented (off-board cells, a player
+// moving twice); such games keep the text form
+QByteArray encodeMoves(const QVector<GameMove>& moves);
+// False for an unknown version or truncated data
+bool decodeMoves(const QByteArray& data, QVector<GameMove>& moves);
+
 struct GameRecord {
+  qint64 id = 0;  // game_history row id; 0 until the record is saved
   QDateTime timestamp;
   QString opponent;
   QString result;
@@ -56,6 +69,16 @@ class User {
   void setGameHistory(const QList<GameRecord>& history) {
     this->gameHistory = history;
   }
+  // Called by UserManager once a new record has been inserted; id 0 marks
+  // it unsaved again after a rolled-back write
+  void markGameSaved(int index, qint64 id) { gameHistory[index].id = id; }
+
+  // Sets all three counters at once, e.g. when loading a user
+  void setGameCounts(int won, int lost, int tied) {
+    gamesWon = won;
+    gamesLost = lost;
+    gamesTied = tied;
+  }
 
   void addWin() { gamesWon++; }
   void addLoss() { gamesLost++; }
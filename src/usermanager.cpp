@@ -1,9 +1,38 @@
 #include "usermanager.h"
 
+#include <QMap>
 #include <QSqlError>
 #include <QSqlQuery>
 
-UserManager::UserManager() : currentUser(nullptr) {
+namespace {
+// Batches keep a transaction open across calls, so each manager needs a
+// connection of its own even when it shares a thread with another
+QString connectionOwner(const UserManager* manager) {
+  return QString("manager-%1").arg(quintptr(manager), 0, 16);
+}
+
+void applyEntry(User& user, const JournalEntry& entry) {
+  user.setGameCounts(user.getGamesWon() + entry.won,
+                     user.getGamesLost() + entry.lost,
+                     user.getGamesTied() + entry.tied);
+  if (entry.hasGame) user.addGameToHistory(entry.game);
+}
+}  // namespace
+
+StatLine UserStatistics::find(const QVector<StatLine>& lines,
+                              const QString& value) {
+  for (const StatLine& line : lines)
+    if (line.value == value) return line;
+  StatLine empty;
+  empty.value = value;
+  return empty;
+}
+
+UserManager::UserManager()
+    : currentUser(nullptr),
+      batchDepth(0),
+      batchFailed(false),
+      batchJournalSequence(0) {
   // Set database path in user's documents folder
   QString documentsPath =
       QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
@@ -14,34 +43,152 @@ UserManager::UserManager() : currentUser(nullptr) {
 }
 
 UserManager::~UserManager() {
-  if (currentUser) {
-    saveUserData();
-    delete currentUser;
+  writeResults();
+  delete currentUser;
+  journal.close();
+
+  // Cached statements must go before the connection closes
+  qDeleteAll(statements);
+  statements.clear();
+  failedStatement = QSqlQuery();
+
+  db = QSqlDatabase();
+  ConnectionPool::release(dbPath, connectionOwner(this));
+}
+
+bool UserManager::initializeDatabase() {
+  // A connection of this manager's own; other threads and other managers
+  // keep theirs and are left alone. The pool has applied the
+  // per-connection tuning; this also sets the journal mode and logs it.
+  db = ConnectionPool::acquire(dbPath, connectionOwner(this));
+  if (!db.isOpen()) return false;
+
+  applyTuning(DatabaseTuning::forDatabase(dbPath));
+
+  if (!migrateSchema()) return false;
+
+  // Results journaled before a crash are written now
+  QString journalPath = QFileInfo(dbPath).absolutePath() + "/results.journal";
+  if (journal.open(journalPath, appliedJournalSequence()) &&
+      !journal.isEmpty()) {
+    qDebug() << "Replaying" << journal.entries().size()
+             << "journaled results";
+    flushJournal();
   }
+  return true;
+}
 
-  if (db.isOpen()) {
-    db.close();
+bool UserManager::applyTuning(const DatabaseTuning& tuning) {
+  bool ok = true;
+  QSqlQuery query(db);
+  for (const QString& pragma : tuning.pragmas()) {
+    if (!query.exec(pragma)) {
+      qDebug() << "Error applying" << pragma << ":" << query.lastError().text();
+      ok = false;
+    }
   }
+  query.finish();
+
+  qDebug().noquote() << "SQLite tuning:" << tuningReport();
+  return ok;
 }
 
-bool UserManager::initializeDatabase() {
-  // Create SQLite database connection
-  db = QSqlDatabase::addDatabase("QSQLITE");
-  db.setDatabaseName(dbPath);
+QString UserManager::tuningReport() const {
+  const char* names[] = {"journal_mode", "synchronous", "cache_size",
+                         "mmap_size",    "temp_store",  "busy_timeout"};
+  QStringList parts;
+  QSqlQuery query(db);
+  for (const char* name : names) {
+    QString value = "?";
+    if (query.exec(QString("PRAGMA %1").arg(name)) && query.next())
+      value = query.value(0).toString();
+    parts << QString("%1=%2").arg(name, value);
+  }
+  return parts.join(' ');
+}
 
-  if (!db.open()) {
-    qDebug() << "Error opening database:" << db.lastError().text();
+bool UserManager::migrateSchema() {
+  // Each step runs once, in order, in its own transaction together with
+  // the version bump. Steps are never edited once released; append new
+  // ones and raise kSchemaVersion.
+  static const struct {
+    const char* description;
+    bool (UserManager::*apply)();
+  } kMigrations[] = {
+      {"users and game_history tables", &UserManager::createBaseSchema},
+      {"binary move lists", &UserManager::addMovesBlob},
+      {"game_analysis table", &UserManager::createAnalysisTable},
+      {"history index on (username, timestamp, id)",
+       &UserManager::createHistoryTimeIndex},
+      {"journal_state table", &UserManager::createJournalState},
+      {"game_history keyed by user_id", &UserManager::keyHistoryByUserId},
+      {"aggregate statistics tables", &UserManager::createStatisticsTables},
+  };
+  static_assert(sizeof(kMigrations) / sizeof(kMigrations[0]) ==
+                    size_t(kSchemaVersion),
+                "kSchemaVersion must match the migration list");
+
+  int version = schemaVersion();
+  if (version == kSchemaVersion) return true;  // current: no DDL at all
+  if (version > kSchemaVersion) {
+    qDebug() << "Database schema version" << version
+             << "is newer than this build supports:" << kSchemaVersion;
     return false;
   }
 
-  return createTables();
+  for (int next = version + 1; next <= kSchemaVersion; ++next) {
+    // Immediate, so no other connection can migrate between the check
+    // below and this step's writes
+    if (!beginBatch(true)) return false;
+    // Another connection may have applied this step meanwhile
+    if (schemaVersion() >= next) {
+      commitBatch();
+      continue;
+    }
+    QSqlQuery query(db);
+    bool ok = (this->*kMigrations[next - 1].apply)() &&
+              query.exec(QString("PRAGMA user_version = %1").arg(next));
+    if (!ok) {
+      qDebug() << "Error migrating schema to version" << next << ":"
+               << query.lastError().text();
+      rollbackBatch();
+      return false;
+    }
+    if (!commitBatch()) return false;
+    qDebug() << "Schema migrated to version" << next << "-"
+             << kMigrations[next - 1].description;
+  }
+  return true;
+}
+
+int UserManager::schemaVersion() const {
+  QSqlQuery query(db);
+  if (query.exec("PRAGMA user_version") && query.next())
+    return query.value(0).toInt();
+  return 0;
+}
+
+bool UserManager::hasColumn(const QString& table, const QString& column) {
+  QSqlQuery query(db);
+  if (!query.exec(QString("PRAGMA table_info(%1)").arg(table))) return false;
+  while (query.next())
+    if (query.value(1).toString() == column) return true;
+  return false;
 }
 
-bool UserManager::createTables() {
+bool UserManager::execSchema(const QString& sql) {
   QSqlQuery query(db);
+  if (!query.exec(sql)) {
+    qDebug() << "Error updating schema:" << query.lastError().text();
+    return false;
+  }
+  return true;
+}
 
-  // Create users table
-  QString createUsersTable = R"(
+// Version 1. Databases from before versioning already have these tables,
+// possibly without moves_data, so every step here tolerates that.
+bool UserManager::createBaseSchema() {
+  bool ok = execSchema(R"(
         CREATE TABLE IF NOT EXISTS users (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             username TEXT UNIQUE NOT NULL,
@@ -53,15 +200,7 @@ bool UserManager::createTables() {
             games_tied INTEGER DEFAULT 0,
             created_at DATETIME DEFAULT CURRENT_TIMESTAMP
         )
-    )";
-
-  if (!query.exec(createUsersTable)) {
-    qDebug() << "Error creating users table:" << query.lastError().text();
-    return false;
-  }
-
-  // Create game_history table with moves_data column
-  QString createHistoryTable = R"(
+    )") && execSchema(R"(
         CREATE TABLE IF NOT EXISTS game_history (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
             username TEXT NOT NULL,
@@ -73,27 +212,239 @@ bool UserManager::createTables() {
             moves_data TEXT,
             FOREIGN KEY (username) REFERENCES users(username)
         )
-    )";
+    )");
+  if (ok && !hasColumn("game_history", "moves_data"))
+    ok = execSchema("ALTER TABLE game_history ADD COLUMN moves_data TEXT");
+  return ok && execSchema(
+                   "CREATE INDEX IF NOT EXISTS idx_game_history_username ON "
+                   "game_history(username)");
+}
 
-  if (!query.exec(createHistoryTable)) {
-    qDebug() << "Error creating game_history table:"
-             << query.lastError().text();
+// Version 2. Moves move to moves_blob; moves_data keeps the legacy text
+// form only for rows the binary format cannot express.
+bool UserManager::addMovesBlob() {
+  if (!hasColumn("game_history", "moves_blob") &&
+      !execSchema("ALTER TABLE game_history ADD COLUMN moves_blob BLOB"))
     return false;
+  return migrateMovesToBlob();
+}
+
+// Version 3. Post-game analysis, one row per analyzed game. accuracy is
+// NULL for games whose moves do not replay, so re-runs skip them too.
+bool UserManager::createAnalysisTable() {
+  return execSchema(R"(
+        CREATE TABLE IF NOT EXISTS game_analysis (
+            game_id INTEGER PRIMARY KEY,
+            accuracy REAL,
+            move_quality TEXT,
+            analyzed_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+            FOREIGN KEY (game_id) REFERENCES game_history(id)
+        )
+    )");
+}
+
+// Version 4. Serves per-user lookups and the (timestamp, id) keyset
+// pages; it replaces the username-only index.
+bool UserManager::createHistoryTimeIndex() {
+  return execSchema(
+             "CREATE INDEX IF NOT EXISTS idx_game_history_user_time ON "
+             "game_history(username, timestamp DESC, id DESC)") &&
+         execSchema("DROP INDEX IF EXISTS idx_game_history_username");
+}
+
+// Version 5. Last result journal sequence written to the tables; entries
+// up to it are already applied if the journal outlived a commit.
+bool UserManager::createJournalState() {
+  return execSchema(R"(
+        CREATE TABLE IF NOT EXISTS journal_state (
+            id INTEGER PRIMARY KEY CHECK (id = 1),
+            applied_sequence INTEGER NOT NULL
+        )
+    )");
+}
+
+// Version 6. History rows reference users by integer id instead of name,
+// and the index covers every list column, so recent games and history
+// pages are index range scans. SQLite cannot change a column in place, so
+// the table is rebuilt; ids are kept, and rows of unknown users dropped.
+bool UserManager::keyHistoryByUserId() {
+  bool ok = execSchema(R"(
+        CREATE TABLE game_history_new (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            user_id INTEGER NOT NULL,
+            timestamp DATETIME NOT NULL,
+            opponent TEXT NOT NULL,
+            result TEXT NOT NULL,
+            game_mode TEXT NOT NULL,
+            player_symbol TEXT NOT NULL,
+            moves_data TEXT,
+            moves_blob BLOB,
+            FOREIGN KEY (user_id) REFERENCES users(id)
+        )
+    )") && execSchema(R"(
+        INSERT INTO game_history_new (id, user_id, timestamp, opponent,
+                                      result, game_mode, player_symbol,
+                                      moves_data, moves_blob)
+        SELECT h.id, u.id, h.timestamp, h.opponent, h.result, h.game_mode,
+               h.player_symbol, h.moves_data, h.moves_blob
+        FROM game_history h
+        JOIN users u ON u.username = h.username
+    )");
+  if (!ok) return false;
+
+  QSqlQuery query(db);
+  if (query.exec("SELECT (SELECT COUNT(*) FROM game_history) - "
+                 "(SELECT COUNT(*) FROM game_history_new)") &&
+      query.next() && query.value(0).toInt() > 0) {
+    qDebug() << "Dropping" << query.value(0).toInt()
+             << "history rows of unknown users";
   }
+  query.finish();
+
+  return execSchema("DROP TABLE game_history") &&
+         execSchema("ALTER TABLE game_history_new RENAME TO game_history") &&
+         execSchema(R"(
+        CREATE INDEX idx_game_history_user_time ON game_history(
+            user_id, timestamp DESC, id DESC, opponent, result, game_mode,
+            player_symbol)
+    )");
+}
 
-  // Add moves_data column if it doesn't exist (for existing databases)
-  QString alterTable = "ALTER TABLE game_history ADD COLUMN moves_data TEXT";
-  query.exec(alterTable);  // This will fail silently if column already exists
+// Version 7. Per-user aggregates, updated in the transaction that inserts
+// each game: win/loss/tie counts per opponent, game mode and symbol in
+// game_stats, and the running streak in user_streaks. Existing history is
+// counted in here.
+bool UserManager::createStatisticsTables() {
+  bool ok = execSchema(R"(
+        CREATE TABLE game_stats (
+            user_id INTEGER NOT NULL,
+            dimension TEXT NOT NULL,
+            value TEXT NOT NULL,
+            won INTEGER NOT NULL DEFAULT 0,
+            lost INTEGER NOT NULL DEFAULT 0,
+            tied INTEGER NOT NULL DEFAULT 0,
+            PRIMARY KEY (user_id, dimension, value),
+            FOREIGN KEY (user_id) REFERENCES users(id)
+        ) WITHOUT ROWID
+    )") && execSchema(R"(
+        CREATE TABLE user_streaks (
+            user_id INTEGER PRIMARY KEY,
+            last_result TEXT NOT NULL,
+            current_length INTEGER NOT NULL,
+            best_win_streak INTEGER NOT NULL,
+            FOREIGN KEY (user_id) REFERENCES users(id)
+        )
+    )");
 
-  // Create index for better performance
-  QString createIndex =
-      "CREATE INDEX IF NOT EXISTS idx_game_history_username ON "
-      "game_history(username)";
-  if (!query.exec(createIndex)) {
-    qDebug() << "Error creating index:" << query.lastError().text();
+  const char* dimensions[][2] = {{"opponent", "opponent"},
+                                 {"mode", "game_mode"},
+                                 {"symbol", "player_symbol"}};
+  for (const auto& dimension : dimensions) {
+    ok = ok && execSchema(QString(R"(
+        INSERT INTO game_stats (user_id, dimension, value, won, lost, tied)
+        SELECT user_id, '%1', %2, SUM(result = 'Won'), SUM(result = 'Lost'),
+               SUM(result = 'Tie')
+        FROM game_history
+        GROUP BY user_id, %2
+    )")
+                                  .arg(dimension[0], dimension[1]));
   }
+  if (!ok) return false;
 
-  return true;
+  // Streaks depend on order, so they are replayed game by game
+  QSqlQuery select(db);
+  select.setForwardOnly(true);
+  if (!select.exec("SELECT user_id, result FROM game_history "
+                   "ORDER BY user_id, timestamp, id"))
+    return false;
+  QSqlQuery insert(db);
+  insert.prepare(
+      "INSERT INTO user_streaks (user_id, last_result, current_length, "
+      "best_win_streak) VALUES (?, ?, ?, ?)");
+  qint64 userId = -1;
+  QString last;
+  int length = 0;
+  int best = 0;
+  auto flush = [&]() {
+    if (userId < 0) return true;
+    insert.addBindValue(userId);
+    insert.addBindValue(last);
+    insert.addBindValue(length);
+    insert.addBindValue(best);
+    return insert.exec();
+  };
+  while (select.next()) {
+    qint64 id = select.value(0).toLongLong();
+    QString result = select.value(1).toString();
+    if (id != userId) {
+      if (!flush()) return false;
+      userId = id;
+      last.clear();
+      length = 0;
+      best = 0;
+    }
+    length = (result == last) ? length + 1 : 1;
+    last = result;
+    if (result == "Won") best = qMax(best, length);
+  }
+  return flush();
+}
+
+QSqlQuery& UserManager::statement(const QString& sql) const {
+  // Prepared once per connection and reused; callers bind fresh values
+  // and must finish() a SELECT so SQLite can reset the statement early.
+  // One that fails to prepare is not cached, so the next call retries;
+  // the failed query is handed back, and exec on it fails.
+  if (QSqlQuery* query = statements.value(sql)) return *query;
+  QSqlQuery* query = new QSqlQuery(db);
+  if (!query->prepare(sql)) {
+    qDebug() << "Error preparing statement:" << query->lastError().text();
+    failedStatement = *query;
+    delete query;
+    return failedStatement;
+  }
+  statements.insert(sql, query);
+  return *query;
+}
+
+bool UserManager::migrateMovesToBlob() {
+  // Converts text move lists left by older versions; rows that do not
+  // parse strictly, or that the binary format cannot represent, keep
+  // their text for the validator to report
+  QSqlQuery select(db);
+  select.setForwardOnly(true);
+  if (!select.exec("SELECT id, moves_data FROM game_history "
+                   "WHERE moves_blob IS NULL AND moves_data IS NOT NULL")) {
+    qDebug() << "Error reading moves to migrate:" << select.lastError().text();
+    return false;
+  }
+
+  QVector<QPair<qint64, QByteArray>> converted;
+  QVector<GameMove> moves;
+  while (select.next()) {
+    if (!GameValidator::parseMoves(select.value(1).toString(), moves))
+      continue;
+    QByteArray blob = encodeMoves(moves);
+    if (!blob.isEmpty()) converted.append({select.value(0).toLongLong(), blob});
+  }
+  select.finish();
+  if (converted.isEmpty()) return true;
+
+  beginBatch();
+  QSqlQuery update(db);
+  update.prepare(
+      "UPDATE game_history SET moves_blob = ?, moves_data = NULL WHERE id = ?");
+  for (const auto& row : converted) {
+    update.addBindValue(row.second);
+    update.addBindValue(row.first);
+    if (!update.exec()) {
+      qDebug() << "Error migrating moves:" << update.lastError().text();
+      rollbackBatch();
+      return false;
+    }
+  }
+  qDebug() << "Migrated" << converted.size() << "move lists to binary";
+  return commitBatch();
 }
 
 bool UserManager::registerUser(const QString& username, const QString& password,
@@ -108,8 +459,7 @@ bool UserManager::registerUser(const QString& username, const QString& password,
 
   QString hashedPassword = hashPassword(password);
 
-  QSqlQuery query(db);
-  query.prepare(
+  QSqlQuery& query = statement(
       "INSERT INTO users (username, password, email, last_login) VALUES (?, ?, "
       "?, CURRENT_TIMESTAMP)");
   query.addBindValue(username);
@@ -125,39 +475,26 @@ bool UserManager::registerUser(const QString& username, const QString& password,
 }
 
 bool UserManager::loginUser(const QString& username, const QString& password) {
-  if (!userExists(username)) {
+  // One query loads the user and recent games; the password is checked
+  // here, so only a successful login costs a write
+  User user = loadUserFromDatabase(username);
+  if (user.getUsername().isEmpty() ||
+      user.getPassword() != hashPassword(password)) {
     return false;
   }
 
-  QString hashedPassword = hashPassword(password);
-
-  QSqlQuery query(db);
-  query.prepare("SELECT password FROM users WHERE username = ?");
-  query.addBindValue(username);
-
-  if (!query.exec() || !query.next()) {
-    return false;
-  }
-
-  QString storedPassword = query.value(0).toString();
-  if (storedPassword != hashedPassword) {
-    return false;
-  }
-
-  // Update last login
-  QSqlQuery updateQuery(db);
-  updateQuery.prepare(
+  QSqlQuery& updateQuery = statement(
       "UPDATE users SET last_login = CURRENT_TIMESTAMP WHERE username = ?");
   updateQuery.addBindValue(username);
   updateQuery.exec();
+  // CURRENT_TIMESTAMP is UTC
+  user.setLastLogin(QDateTime::currentDateTimeUtc());
 
-  // Load user data
-  if (currentUser) {
-    delete currentUser;
-  }
-
-  currentUser = new User();
-  *currentUser = loadUserFromDatabase(username);
+  delete currentUser;
+  currentUser = new User(user);
+  // Results still waiting in the journal belong to the loaded state too
+  for (const JournalEntry& entry : journal.entries())
+    if (entry.username == username) applyEntry(*currentUser, entry);
 
   return true;
 }
@@ -171,15 +508,12 @@ void UserManager::logoutUser() {
 }
 
 bool UserManager::userExists(const QString& username) const {
-  QSqlQuery query(db);
-  query.prepare("SELECT COUNT(*) FROM users WHERE username = ?");
+  QSqlQuery& query = statement("SELECT COUNT(*) FROM users WHERE username = ?");
   query.addBindValue(username);
 
-  if (query.exec() && query.next()) {
-    return query.value(0).toInt() > 0;
-  }
-
-  return false;
+  bool exists = query.exec() && query.next() && query.value(0).toInt() > 0;
+  query.finish();
+  return exists;
 }
 
 QStringList UserManager::getAllUsernames() const {
@@ -200,11 +534,152 @@ QString UserManager::hashPassword(const QString& password) const {
 }
 
 void UserManager::saveUserData() {
+  if (currentUser) writeResults();
+}
+
+void UserManager::recordStats(bool won, bool lost, bool tied) {
   if (!currentUser) return;
+  JournalEntry entry;
+  entry.username = currentUser->getUsername();
+  entry.won = won;
+  entry.lost = lost;
+  entry.tied = tied;
+  journalEntry(entry);
+}
+
+void UserManager::recordGame(const GameRecord& record) {
+  if (!currentUser) return;
+  JournalEntry entry;
+  entry.username = currentUser->getUsername();
+  entry.hasGame = true;
+  entry.game = record;
+  journalEntry(entry);
+}
+
+void UserManager::journalEntry(JournalEntry& entry) {
+  applyEntry(*currentUser, entry);
+  // Without a working journal the result is saved straight away instead
+  if (!journal.append(entry)) writeResults();
+}
+
+bool UserManager::flushJournal() {
+  return journal.isEmpty() || writeResults();
+}
+
+bool UserManager::writeResults() {
+  if (!currentUser && journal.isEmpty()) return true;
+
+  // Users other than the signed-in one only have results in the journal
+  // after a crash or a failed flush; apply those to their stored state
+  QString signedIn = currentUser ? currentUser->getUsername() : QString();
+  QMap<QString, User> others;
+  for (const JournalEntry& entry : journal.entries()) {
+    if (entry.username == signedIn) continue;
+    if (!others.contains(entry.username))
+      others.insert(entry.username, loadUserFromDatabase(entry.username));
+    applyEntry(others[entry.username], entry);
+  }
+
+  // Stats, new games and the journal position in one transaction: a single
+  // sync to disk, and a failed insert leaves nothing half-written
+  beginBatch();
+  bool ok = true;
+  for (User& user : others) {
+    if (user.getUsername().isEmpty()) continue;  // deleted since
+    ok = ok && saveUserToDatabase(user) && saveGameHistoryToDatabase(user);
+  }
+  if (currentUser)
+    ok = ok && saveUserToDatabase(*currentUser) &&
+         saveGameHistoryToDatabase(*currentUser);
+
+  // Only the manager that holds the journal open may move its position
+  if (ok && journal.isOpen() && !journal.isEmpty()) {
+    QSqlQuery& query = statement(
+        "INSERT OR REPLACE INTO journal_state (id, applied_sequence) "
+        "VALUES (1, ?)");
+    query.addBindValue(journal.lastSequence());
+    ok = query.exec();
+    if (ok) batchJournalSequence = journal.lastSequence();
+  }
+
+  if (!ok) {
+    rollbackBatch();
+    return false;
+  }
+  return commitBatch();
+}
+
+qint64 UserManager::appliedJournalSequence() const {
+  QSqlQuery& query =
+      statement("SELECT applied_sequence FROM journal_state WHERE id = 1");
+  qint64 sequence = 0;
+  if (query.exec() && query.next()) sequence = query.value(0).toLongLong();
+  query.finish();
+  return sequence;
+}
+
+bool UserManager::beginBatch(bool immediate) {
+  if (batchDepth++ > 0) return true;
+
+  batchFailed = false;
+  batchGameIds.clear();
+  batchJournalSequence = 0;
+  QSqlQuery begin(db);
+  bool ok = immediate ? begin.exec("BEGIN IMMEDIATE") : db.transaction();
+  if (!ok) {
+    qDebug() << "Error starting transaction:"
+             << (immediate ? begin.lastError() : db.lastError()).text();
+    batchDepth = 0;
+    return false;
+  }
+  return true;
+}
+
+bool UserManager::commitBatch() {
+  if (batchDepth == 0) return false;
+  if (--batchDepth > 0) return !batchFailed;
+
+  if (batchFailed) {
+    db.rollback();
+    forgetBatchGameIds();
+    return false;
+  }
+  if (!db.commit()) {
+    qDebug() << "Error committing transaction:" << db.lastError().text();
+    db.rollback();
+    forgetBatchGameIds();
+    return false;
+  }
+  batchGameIds.clear();
+
+  // Journaled results are durable in SQLite now
+  if (batchJournalSequence > 0) {
+    journal.discardThrough(batchJournalSequence);
+    batchJournalSequence = 0;
+  }
+  return true;
+}
+
+void UserManager::rollbackBatch() {
+  if (batchDepth == 0) return;
+  // An inner rollback fails the batch; the outermost level undoes it
+  batchFailed = true;
+  if (--batchDepth > 0) return;
+
+  db.rollback();
+  forgetBatchGameIds();
+}
 
-  saveUserToDatabase(*currentUser);
-  saveGameHistoryToDatabase(currentUser->getUsername(),
-                            currentUser->getGameHistory());
+void UserManager::forgetBatchGameIds() {
+  // Rows the rolled-back batch inserted are gone; save them again next time
+  batchJournalSequence = 0;
+  if (currentUser && !batchGameIds.isEmpty()) {
+    QList<GameRecord> history = currentUser->getGameHistory();
+    for (int i = 0; i < history.size(); ++i)
+      if (batchGameIds.contains(history[i].id))
+        currentUser->markGameSaved(i, 0);
+  }
+  batchGameIds.clear();
 }
 
 void UserManager::loadUserData() {
@@ -213,8 +688,7 @@ void UserManager::loadUserData() {
 }
 
 bool UserManager::saveUserToDatabase(const User& user) {
-  QSqlQuery query(db);
-  query.prepare(R"(
+  QSqlQuery& query = statement(R"(
         UPDATE users
         SET email = ?, games_won = ?, games_lost = ?, games_tied = ?
         WHERE username = ?
@@ -237,84 +711,171 @@ bool UserManager::saveUserToDatabase(const User& user) {
 User UserManager::loadUserFromDatabase(const QString& username) {
   User user;
 
-  QSqlQuery query(db);
-  query.prepare(R"(
-        SELECT username, password, email, last_login, games_won, games_lost, games_tied
-        FROM users WHERE username = ?
+  // The user row joined with its five most recent games, newest first;
+  // the games come from the history index, so the cost does not grow
+  // with the number of games played
+  QSqlQuery& query = statement(R"(
+        SELECT u.password, u.email, u.last_login, u.games_won,
+               u.games_lost, u.games_tied, h.id, h.timestamp, h.opponent,
+               h.result, h.game_mode, h.player_symbol, h.moves_data,
+               h.moves_blob
+        FROM users u
+        LEFT JOIN game_history h ON h.id IN (
+            SELECT id FROM game_history
+            WHERE user_id = u.id
+            ORDER BY timestamp DESC, id DESC
+            LIMIT 5)
+        WHERE u.username = ?
+        ORDER BY h.timestamp DESC, h.id DESC
     )");
   query.addBindValue(username);
 
-  if (query.exec() && query.next()) {
-    user.setUsername(query.value("username").toString());
-    user.setPassword(query.value("password").toString());
-    user.setEmail(query.value("email").toString());
-    user.setLastLogin(query.value("last_login").toDateTime());
-
-    // Load game statistics
-    int gamesWon = query.value("games_won").toInt();
-    int gamesLost = query.value("games_lost").toInt();
-    int gamesTied = query.value("games_tied").toInt();
-
-    for (int i = 0; i < gamesWon; i++) user.addWin();
-    for (int i = 0; i < gamesLost; i++) user.addLoss();
-    for (int i = 0; i < gamesTied; i++) user.addTie();
+  if (!query.exec()) {
+    qDebug() << "Error loading user:" << query.lastError().text();
+    return user;
+  }
 
-    // Load only last 5 games for display, but keep reference to all
-    QList<GameRecord> history = loadGameHistoryFromDatabase(username);
-    user.setGameHistory(history);
+  QList<GameRecord> history;
+  while (query.next()) {
+    if (user.getUsername().isEmpty()) {
+      user.setUsername(username);
+      user.setPassword(query.value(0).toString());
+      user.setEmail(query.value(1).toString());
+      user.setLastLogin(query.value(2).toDateTime());
+      user.setGameCounts(query.value(3).toInt(), query.value(4).toInt(),
+                         query.value(5).toInt());
+    }
+    if (query.value(6).isNull()) continue;  // no games yet
+
+    GameRecord record;
+    record.id = query.value(6).toLongLong();
+    record.timestamp = query.value(7).toDateTime();
+    record.opponent = query.value(8).toString();
+    record.result = query.value(9).toString();
+    record.gameMode = query.value(10).toString();
+    record.playerSymbol = query.value(11).toString();
+    record.moves = movesFromRow(query.value(13).toByteArray(),
+                                query.value(12).toString());
+    history.append(record);
   }
+  query.finish();
 
+  user.setGameHistory(history);
   return user;
 }
 
-bool UserManager::saveGameHistoryToDatabase(const QString& username,
-                                            const QList<GameRecord>& history) {
-  // Delete existing history for this user
-  QSqlQuery deleteQuery(db);
-  deleteQuery.prepare("DELETE FROM game_history WHERE username = ?");
-  deleteQuery.addBindValue(username);
-
-  if (!deleteQuery.exec()) {
-    qDebug() << "Error deleting old game history:"
-             << deleteQuery.lastError().text();
-    return false;
-  }
-
-  // Insert new history records
-  QSqlQuery insertQuery(db);
-  insertQuery.prepare(R"(
-        INSERT INTO game_history (username, timestamp, opponent, result, game_mode, player_symbol, moves_data)
-        VALUES (?, ?, ?, ?, ?, ?, ?)
+bool UserManager::saveGameHistoryToDatabase(User& user) {
+  // History is append-only: rows already in the table are never rewritten,
+  // so a finished game costs one insert however long the history is
+  QList<GameRecord> history = user.getGameHistory();
+
+  QSqlQuery& insertQuery = statement(R"(
+        INSERT INTO game_history (user_id, timestamp, opponent, result,
+                                  game_mode, player_symbol, moves_data,
+                                  moves_blob)
+        VALUES ((SELECT id FROM users WHERE username = ?), ?, ?, ?, ?, ?, ?,
+                ?)
     )");
 
-  for (const GameRecord& record : history) {
-    insertQuery.addBindValue(username);
+  // New games are prepended, so walk backwards to insert oldest first
+  for (int i = history.size() - 1; i >= 0; --i) {
+    const GameRecord& record = history[i];
+    if (record.id != 0) continue;
+
+    insertQuery.addBindValue(user.getUsername());
     insertQuery.addBindValue(record.timestamp);
     insertQuery.addBindValue(record.opponent);
     insertQuery.addBindValue(record.result);
     insertQuery.addBindValue(record.gameMode);
     insertQuery.addBindValue(record.playerSymbol);
-    insertQuery.addBindValue(movesToString(record.moves));
+    // Binary when representable; otherwise keep the moves as text
+    QByteArray blob = encodeMoves(record.moves);
+    if (blob.isEmpty()) {
+      insertQuery.addBindValue(movesToString(record.moves));
+      insertQuery.addBindValue(QVariant());
+    } else {
+      insertQuery.addBindValue(QVariant());
+      insertQuery.addBindValue(blob);
+    }
 
     if (!insertQuery.exec()) {
       qDebug() << "Error saving game record:" << insertQuery.lastError().text();
       return false;
     }
+    qint64 id = insertQuery.lastInsertId().toLongLong();
+    user.markGameSaved(i, id);
+    if (batchDepth > 0) batchGameIds.append(id);
+
+    if (!updateStatistics(user.getUsername(), record)) return false;
   }
 
   return true;
 }
 
+bool UserManager::updateStatistics(const QString& username,
+                                   const GameRecord& record) {
+  int won = record.result == "Won";
+  int lost = record.result == "Lost";
+  int tied = record.result == "Tie";
+
+  QSqlQuery& stats = statement(R"(
+        INSERT INTO game_stats (user_id, dimension, value, won, lost, tied)
+        VALUES ((SELECT id FROM users WHERE username = ?), ?, ?, ?, ?, ?)
+        ON CONFLICT (user_id, dimension, value) DO UPDATE SET
+            won = won + excluded.won,
+            lost = lost + excluded.lost,
+            tied = tied + excluded.tied
+    )");
+  const QString dimensions[][2] = {{"opponent", record.opponent},
+                                   {"mode", record.gameMode},
+                                   {"symbol", record.playerSymbol}};
+  for (const auto& dimension : dimensions) {
+    stats.addBindValue(username);
+    stats.addBindValue(dimension[0]);
+    stats.addBindValue(dimension[1]);
+    stats.addBindValue(won);
+    stats.addBindValue(lost);
+    stats.addBindValue(tied);
+    if (!stats.exec()) {
+      qDebug() << "Error updating statistics:" << stats.lastError().text();
+      return false;
+    }
+  }
+
+  // Every right-hand side sees the row as it was before this game
+  QSqlQuery& streak = statement(R"(
+        INSERT INTO user_streaks (user_id, last_result, current_length,
+                                  best_win_streak)
+        VALUES ((SELECT id FROM users WHERE username = ?), ?, 1, ?)
+        ON CONFLICT (user_id) DO UPDATE SET
+            current_length = CASE WHEN last_result = excluded.last_result
+                                  THEN current_length + 1 ELSE 1 END,
+            best_win_streak = MAX(best_win_streak,
+                CASE WHEN excluded.last_result != 'Won' THEN 0
+                     WHEN last_result = 'Won' THEN current_length + 1
+                     ELSE 1 END),
+            last_result = excluded.last_result
+    )");
+  streak.addBindValue(username);
+  streak.addBindValue(record.result);
+  streak.addBindValue(won);
+  if (!streak.exec()) {
+    qDebug() << "Error updating streak:" << streak.lastError().text();
+    return false;
+  }
+  return true;
+}
+
 QList<GameRecord> UserManager::loadGameHistoryFromDatabase(
     const QString& username) {
   QList<GameRecord> history;
 
-  QSqlQuery query(db);
-  query.prepare(R"(
-        SELECT timestamp, opponent, result, game_mode, player_symbol, moves_data
+  QSqlQuery& query = statement(R"(
+        SELECT id, timestamp, opponent, result, game_mode, player_symbol,
+               moves_data, moves_blob
         FROM game_history
-        WHERE username = ?
-        ORDER BY timestamp DESC
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+        ORDER BY timestamp DESC, id DESC
         LIMIT 5
     )");
   query.addBindValue(username);
@@ -322,19 +883,19 @@ QList<GameRecord> UserManager::loadGameHistoryFromDatabase(
   if (query.exec()) {
     while (query.next()) {
       GameRecord record;
+      record.id = query.value("id").toLongLong();
       record.timestamp = query.value("timestamp").toDateTime();
       record.opponent = query.value("opponent").toString();
       record.result = query.value("result").toString();
       record.gameMode = query.value("game_mode").toString();
       record.playerSymbol = query.value("player_symbol").toString();
 
-      QString movesData = query.value("moves_data").toString();
-      if (!movesData.isEmpty()) {
-        record.moves = movesFromString(movesData);
-      }
+      record.moves = movesFromRow(query.value("moves_blob").toByteArray(),
+                                  query.value("moves_data").toString());
 
       history.append(record);
     }
+    query.finish();
   } else {
     qDebug() << "Error loading game history:" << query.lastError().text();
   }
@@ -346,31 +907,31 @@ QList<GameRecord> UserManager::loadAllGameHistoryFromDatabase(
     const QString& username) {
   QList<GameRecord> history;
 
-  QSqlQuery query(db);
-  query.prepare(R"(
-        SELECT timestamp, opponent, result, game_mode, player_symbol, moves_data
+  QSqlQuery& query = statement(R"(
+        SELECT id, timestamp, opponent, result, game_mode, player_symbol,
+               moves_data, moves_blob
         FROM game_history
-        WHERE username = ?
-        ORDER BY timestamp DESC
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+        ORDER BY timestamp DESC, id DESC
     )");
   query.addBindValue(username);
 
   if (query.exec()) {
     while (query.next()) {
       GameRecord record;
+      record.id = query.value("id").toLongLong();
       record.timestamp = query.value("timestamp").toDateTime();
       record.opponent = query.value("opponent").toString();
       record.result = query.value("result").toString();
       record.gameMode = query.value("game_mode").toString();
       record.playerSymbol = query.value("player_symbol").toString();
 
-      QString movesData = query.value("moves_data").toString();
-      if (!movesData.isEmpty()) {
-        record.moves = movesFromString(movesData);
-      }
+      record.moves = movesFromRow(query.value("moves_blob").toByteArray(),
+                                  query.value("moves_data").toString());
 
       history.append(record);
     }
+    query.finish();
   } else {
     qDebug() << "Error loading all game history:" << query.lastError().text();
   }
@@ -378,6 +939,277 @@ QList<GameRecord> UserManager::loadAllGameHistoryFromDatabase(
   return history;
 }
 
+QList<GameRecord> UserManager::loadGameHistoryPage(const QString& username,
+                                                  HistoryCursor& cursor,
+                                                  int limit) {
+  QList<GameRecord> page;
+  // Games still in the journal belong at the top of the first page
+  if (cursor.id == 0) flushJournal();
+
+  // Seeks straight to the cursor in the covering (user_id, timestamp, id)
+  // index, so every page costs the same however deep the user scrolls
+  static const char kFirstPage[] = R"(
+        SELECT id, timestamp, opponent, result, game_mode, player_symbol
+        FROM game_history
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+        ORDER BY timestamp DESC, id DESC
+        LIMIT ?
+    )";
+  static const char kNextPage[] = R"(
+        SELECT id, timestamp, opponent, result, game_mode, player_symbol
+        FROM game_history
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+          AND (timestamp, id) < (?, ?)
+        ORDER BY timestamp DESC, id DESC
+        LIMIT ?
+    )";
+  bool first = cursor.id == 0;
+  QSqlQuery& query = statement(first ? kFirstPage : kNextPage);
+  query.addBindValue(username);
+  if (!first) {
+    query.addBindValue(cursor.timestamp);
+    query.addBindValue(cursor.id);
+  }
+  query.addBindValue(limit);
+
+  if (query.exec()) {
+    while (query.next()) {
+      GameRecord record;
+      record.id = query.value(0).toLongLong();
+      record.timestamp = query.value(1).toDateTime();
+      record.opponent = query.value(2).toString();
+      record.result = query.value(3).toString();
+      record.gameMode = query.value(4).toString();
+      record.playerSymbol = query.value(5).toString();
+      page.append(record);
+
+      // The raw column value, so the next comparison matches exactly
+      cursor.timestamp = query.value(1);
+      cursor.id = record.id;
+    }
+    query.finish();
+  } else {
+    qDebug() << "Error loading game history page:"
+             << query.lastError().text();
+  }
+
+  return page;
+}
+
+QVector<GameMove> UserManager::loadGameMoves(qint64 gameId) {
+  QVector<GameMove> moves;
+  QSqlQuery& query = statement(
+      "SELECT moves_blob, moves_data FROM game_history WHERE id = ?");
+  query.addBindValue(gameId);
+  if (query.exec() && query.next()) {
+    moves = movesFromRow(query.value(0).toByteArray(),
+                         query.value(1).toString());
+  }
+  query.finish();
+  return moves;
+}
+
+UserStatistics UserManager::loadStatistics(const QString& username) {
+  UserStatistics statistics;
+  // The aggregates only change when results reach SQLite; without this a
+  // game still in the journal would be missing next to counters that
+  // already include it
+  flushJournal();
+
+  QSqlQuery& query = statement(R"(
+        SELECT dimension, value, won, lost, tied
+        FROM game_stats
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+        ORDER BY won + lost + tied DESC, value
+    )");
+  query.addBindValue(username);
+  if (query.exec()) {
+    while (query.next()) {
+      StatLine line;
+      line.value = query.value(1).toString();
+      line.won = query.value(2).toInt();
+      line.lost = query.value(3).toInt();
+      line.tied = query.value(4).toInt();
+
+      QString dimension = query.value(0).toString();
+      if (dimension == "opponent")
+        statistics.byOpponent.append(line);
+      else if (dimension == "mode")
+        statistics.byMode.append(line);
+      else if (dimension == "symbol")
+        statistics.bySymbol.append(line);
+    }
+  } else {
+    qDebug() << "Error loading statistics:" << query.lastError().text();
+  }
+  query.finish();
+
+  QSqlQuery& streak = statement(R"(
+        SELECT last_result, current_length, best_win_streak
+        FROM user_streaks
+        WHERE user_id = (SELECT id FROM users WHERE username = ?)
+    )");
+  streak.addBindValue(username);
+  if (streak.exec() && streak.next()) {
+    statistics.streakResult = streak.value(0).toString();
+    statistics.streakLength = streak.value(1).toInt();
+    statistics.bestWinStreak = streak.value(2).toInt();
+  }
+  streak.finish();
+
+  return statistics;
+}
+
+ValidationReport UserManager::validateGameHistory(int threadCount) {
+  // Rows are read here, on the connection's thread; parsing and replay
+  // run on the validator's worker threads
+  QVector<StoredGame> games;
+  QSqlQuery query(db);
+  query.setForwardOnly(true);
+  if (query.exec("SELECT h.id, u.username, h.result, h.player_symbol, "
+                 "h.moves_data, h.moves_blob FROM game_history h "
+                 "JOIN users u ON u.id = h.user_id")) {
+    while (query.next()) {
+      StoredGame game;
+      game.id = query.value(0).toLongLong();
+      game.username = query.value(1).toString();
+      game.result = query.value(2).toString();
+      game.playerSymbol = query.value(3).toString();
+      game.movesData = query.value(4).toString();
+      game.movesBlob = query.value(5).toByteArray();
+      games.append(game);
+    }
+  } else {
+    qDebug() << "Error reading game history:" << query.lastError().text();
+  }
+
+  return GameValidator::validateAll(games, threadCount);
+}
+
+int UserManager::analyzeGameHistory(int threadCount) {
+  // Drop analysis of games that are no longer in the history
+  QSqlQuery cleanup(db);
+  if (!cleanup.exec("DELETE FROM game_analysis WHERE game_id NOT IN "
+                    "(SELECT id FROM game_history)")) {
+    qDebug() << "Error pruning game analysis:" << cleanup.lastError().text();
+  }
+
+  QVector<StoredGame> pending;
+  QSqlQuery query(db);
+  query.setForwardOnly(true);
+  if (!query.exec(R"(
+        SELECT h.id, h.moves_data, h.moves_blob
+        FROM game_history h
+        LEFT JOIN game_analysis a ON a.game_id = h.id
+        WHERE a.game_id IS NULL
+        ORDER BY h.id
+    )")) {
+    qDebug() << "Error reading games to analyze:" << query.lastError().text();
+    return 0;
+  }
+  while (query.next()) {
+    StoredGame game;
+    game.id = query.value(0).toLongLong();
+    game.movesData = query.value(1).toString();
+    game.movesBlob = query.value(2).toByteArray();
+    pending.append(game);
+  }
+
+  // Each batch is committed on its own, so an interrupted run keeps
+  // everything finished so far and the next run picks up the rest
+  const int kBatchGames = 512;
+  int analyzed = 0;
+  QSqlQuery& insertQuery = statement(
+      "INSERT OR REPLACE INTO game_analysis (game_id, accuracy, move_quality) "
+      "VALUES (?, ?, ?)");
+
+  for (int begin = 0; begin < pending.size(); begin += kBatchGames) {
+    QVector<GameAnalysis> results = GameAnalyzer::analyzeAll(
+        pending.mid(begin, kBatchGames), threadCount);
+
+    beginBatch();
+    for (const GameAnalysis& analysis : results) {
+      insertQuery.addBindValue(analysis.gameId);
+      insertQuery.addBindValue(analysis.valid ? QVariant(analysis.accuracy)
+                                              : QVariant());
+      insertQuery.addBindValue(analysis.qualityString());
+      if (!insertQuery.exec()) {
+        qDebug() << "Error saving game analysis:"
+                 << insertQuery.lastError().text();
+        rollbackBatch();
+        return analyzed;
+      }
+    }
+    if (!commitBatch()) return analyzed;
+    analyzed += results.size();
+  }
+
+  return analyzed;
+}
+
+QVector<GameAnalysis> UserManager::loadGameAnalysis(const QString& username) {
+  QVector<GameAnalysis> analyses;
+
+  QSqlQuery& query = statement(R"(
+        SELECT a.game_id, a.accuracy, a.move_quality
+        FROM game_analysis a
+        JOIN game_history h ON h.id = a.game_id
+        WHERE h.user_id = (SELECT id FROM users WHERE username = ?)
+        ORDER BY h.timestamp DESC
+    )");
+  query.addBindValue(username);
+
+  if (query.exec()) {
+    while (query.next()) {
+      GameAnalysis analysis;
+      analysis.gameId = query.value(0).toLongLong();
+      analysis.valid = !query.value(1).isNull();
+      analysis.accuracy = query.value(1).toDouble();
+      analysis.moves =
+          GameAnalysis::qualityFromString(query.value(2).toString());
+      analyses.append(analysis);
+    }
+    query.finish();
+  } else {
+    qDebug() << "Error loading game analysis:" << query.lastError().text();
+  }
+
+  return analyses;
+}
+
+GameAnalysis UserManager::loadGameAnalysis(qint64 gameId) {
+  GameAnalysis analysis;
+
+  QSqlQuery& query = statement(R"(
+        SELECT accuracy, move_quality FROM game_analysis WHERE game_id = ?
+    )");
+  query.addBindValue(gameId);
+
+  if (query.exec()) {
+    if (query.next()) {
+      analysis.gameId = gameId;
+      analysis.valid = !query.value(0).isNull();
+      analysis.accuracy = query.value(0).toDouble();
+      analysis.moves =
+          GameAnalysis::qualityFromString(query.value(1).toString());
+    }
+    query.finish();
+  } else {
+    qDebug() << "Error loading game analysis:" << query.lastError().text();
+  }
+
+  return analysis;
+}
+
+QVector<GameMove> UserManager::movesFromRow(const QByteArray& blob,
+                                           const QString& text) const {
+  QVector<GameMove> moves;
+  if (blob.isEmpty()) return movesFromString(text);
+  if (!decodeMoves(blob, moves))
+    qDebug() << "Unreadable move data, format" << int(blob.at(0));
+  return moves;
+}
+
 QString UserManager::movesToString(const QVector<GameMove>& moves) const {
   QStringList moveStrings;
   for (const GameMove& move : moves) {
@@ -4,14 +4,53 @@
 #include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QSettings>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QStandardPaths>
 #include <QString>
 
+#include "connectionpool.h"
+#include "databasetuning.h"
+#include "gameanalyzer.h"
+#include "gamevalidator.h"
+#include "resultjournal.h"
 #include "user.h"
 
+// Position in a user's history for keyset pagination: the last row read.
+// A default cursor starts at the newest game.
+struct HistoryCursor {
+  QVariant timestamp;  // raw column value of the last row
+  qint64 id = 0;
+};
+
+// Results of one user's games grouped by one attribute, e.g. one opponent
+struct StatLine {
+  QString value;
+  int won = 0;
+  int lost = 0;
+  int tied = 0;
+
+  int total() const { return won + lost + tied; }
+};
+
+// Aggregates kept in step with every saved game, so reading them costs
+// the same however long the history is. Lines are most played first.
+struct UserStatistics {
+  QVector<StatLine> byOpponent;
+  QVector<StatLine> byMode;
+  QVector<StatLine> bySymbol;
+  QString streakResult;  // "Won", "Lost" or "Tie"; empty with no games
+  int streakLength = 0;
+  int bestWinStreak = 0;
+
+  // The line for value, or an empty one
+  static StatLine find(const QVector<StatLine>& lines, const QString& value);
+};
+
 class UserManager {
  public:
   UserManager();
@@ -26,29 +65,107 @@ class UserManager {
 
   void saveUserData();
   void loadUserData();
+
+  // Write-behind game results: applied to the signed-in user at once and
+  // synced to the journal, but written to SQLite only by flushJournal,
+  // saveUserData, logout or shutdown. Entries left by a crash are written
+  // when the database is next opened.
+  void recordStats(bool won, bool lost, bool tied);
+  void recordGame(const GameRecord& record);
+  bool flushJournal();
+
+  // Groups every write until the matching commitBatch into one SQLite
+  // transaction. Batches nest and only the outermost commit reaches the
+  // disk; a rollback anywhere discards the whole batch, and new games it
+  // had inserted are marked unsaved again. An immediate batch takes the
+  // write lock up front (BEGIN IMMEDIATE), so what it reads cannot change
+  // before it writes.
+  bool beginBatch(bool immediate = false);
+  bool commitBatch();
+  void rollbackBatch();
   bool userExists(const QString& username) const;
+  QString databasePath() const { return dbPath; }
   QStringList getAllUsernames() const;
 
+  // Applies a tuning profile to the open connection and logs the result
+  bool applyTuning(const DatabaseTuning& tuning);
+  // Effective settings as reported by SQLite, e.g. "journal_mode=wal ..."
+  QString tuningReport() const;
+
+  // Schema version this build migrates databases to (PRAGMA user_version)
+  static constexpr int kSchemaVersion = 7;
+  int schemaVersion() const;
+
   // Made public for replay functionality
   QList<GameRecord> loadGameHistoryFromDatabase(const QString& username);
   QList<GameRecord> loadAllGameHistoryFromDatabase(const QString& username);
 
+  // Up to limit games after cursor, newest first, without move data; the
+  // cursor is advanced past the returned rows
+  QList<GameRecord> loadGameHistoryPage(const QString& username,
+                                        HistoryCursor& cursor, int limit);
+  QVector<GameMove> loadGameMoves(qint64 gameId);
+
+  // Integrity sweep: replays every stored game of every user through the
+  // engine on threadCount threads (0 = hardware concurrency)
+  ValidationReport validateGameHistory(int threadCount = 0);
+
+  // Runs post-game analysis on every stored game that has none yet and
+  // saves it in batches; returns the number of games analyzed
+  int analyzeGameHistory(int threadCount = 0);
+  // Saved analyses of username's games, newest first
+  QVector<GameAnalysis> loadGameAnalysis(const QString& username);
+  // Saved analysis of one game; gameId stays 0 if it has none yet
+  GameAnalysis loadGameAnalysis(qint64 gameId);
+
+  // Flushes the journal first, so recorded results are always included
+  UserStatistics loadStatistics(const QString& username);
+
  private:
   QSqlDatabase db;
   User* currentUser;
   QString dbPath;
+  int batchDepth;
+  bool batchFailed;
+  QList<qint64> batchGameIds;  // rows inserted by the open batch
+  mutable QHash<QString, QSqlQuery*> statements;  // owned, keyed by SQL
+  mutable QSqlQuery failedStatement;  // returned when prepare fails
+  ResultJournal journal;
+  qint64 batchJournalSequence;  // journal applied by the open batch
 
   bool initializeDatabase();
+  QSqlQuery& statement(const QString& sql) const;
   QString hashPassword(const QString& password) const;
-  bool createTables();
+  // Brings the schema up to kSchemaVersion; does nothing when current
+  bool migrateSchema();
+  bool hasColumn(const QString& table, const QString& column);
+  bool execSchema(const QString& sql);
+  bool createBaseSchema();
+  bool addMovesBlob();
+  bool createAnalysisTable();
+  bool createHistoryTimeIndex();
+  bool createJournalState();
+  bool keyHistoryByUserId();
+  bool createStatisticsTables();
   bool saveUserToDatabase(const User& user);
   User loadUserFromDatabase(const QString& username);
-  bool saveGameHistoryToDatabase(const QString& username,
-                                 const QList<GameRecord>& history);
+  // Inserts only the user's records that have no row id yet
+  bool saveGameHistoryToDatabase(User& user);
+  // Adds one newly inserted game to the aggregate tables
+  bool updateStatistics(const QString& username, const GameRecord& record);
+  void forgetBatchGameIds();
+  // Saves the signed-in user and every journaled result in one batch
+  bool writeResults();
+  void journalEntry(JournalEntry& entry);
+  qint64 appliedJournalSequence() const;
 
   // Helper methods for move serialization
   QString movesToString(const QVector<GameMove>& moves) const;
   QVector<GameMove> movesFromString(const QString& movesStr) const;
+  // Binary column when set, else the legacy text
+  QVector<GameMove> movesFromRow(const QByteArray& blob,
+                                 const QString& text) const;
+  bool migrateMovesToBlob();
 };
 
 #endif  // USERMANAGER_H
@@ -0,0 +1,148 @@
+#include <QApplication>
+#include <QSettings>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "connectionpool.h"
+#include "databasetuning.h"
+
+class TestConnectionPool : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void initTestCase();
+  void testSameThreadSharesConnection();
+  void testOwnerGetsOwnConnection();
+  void testLastReleaseClosesConnection();
+  void testThreadsReadConcurrently();
+  void testNewConnectionsTuned();
+
+ private:
+  QTemporaryDir dir;
+  QString path;
+};
+
+void TestConnectionPool::initTestCase() {
+  path = dir.filePath("pool.db");
+  PooledConnection connection(path);
+  QSqlQuery query(connection.database());
+  QVERIFY(query.exec("PRAGMA journal_mode = WAL"));
+  QVERIFY(query.exec("CREATE TABLE numbers (value INTEGER)"));
+  for (int i = 1; i <= 100; ++i)
+    QVERIFY(query.exec(QString("INSERT INTO numbers VALUES (%1)").arg(i)));
+}
+
+void TestConnectionPool::testSameThreadSharesConnection() {
+  PooledConnection first(path);
+  PooledConnection second(path);
+  QVERIFY(first.database().isOpen());
+  QCOMPARE(first.database().connectionName(),
+           second.database().connectionName());
+  QCOMPARE(first.database().connectionName(),
+           ConnectionPool::connectionName(path));
+}
+
+void TestConnectionPool::testOwnerGetsOwnConnection() {
+  PooledConnection shared(path);
+  QSqlDatabase owned = ConnectionPool::acquire(path, "owner");
+  QVERIFY(owned.isOpen());
+  QVERIFY(owned.connectionName() != shared.database().connectionName());
+
+  // Each connection has its own transaction
+  QVERIFY(owned.transaction());
+  QVERIFY(shared.database().transaction());
+  QVERIFY(shared.database().commit());
+  QVERIFY(owned.commit());
+
+  QString name = owned.connectionName();
+  owned = QSqlDatabase();
+  ConnectionPool::release(path, "owner");
+  QVERIFY(!QSqlDatabase::contains(name));
+}
+
+void TestConnectionPool::testLastReleaseClosesConnection() {
+  QString name = ConnectionPool::connectionName(path);
+  {
+    PooledConnection outer(path);
+    {
+      PooledConnection inner(path);
+    }
+    QVERIFY(QSqlDatabase::contains(name));
+    QVERIFY(outer.database().isOpen());
+  }
+  QVERIFY(!QSqlDatabase::contains(name));
+}
+
+void TestConnectionPool::testThreadsReadConcurrently() {
+  // A writer holds an open transaction while the readers run
+  PooledConnection writer(path);
+  QVERIFY(writer.database().transaction());
+  QSqlQuery insert(writer.database());
+  QVERIFY(insert.exec("INSERT INTO numbers VALUES (1000)"));
+
+  const int kThreads = 4;
+  std::atomic<int> succeeded(0);
+  std::vector<QString> names(kThreads);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < kThreads; ++t) {
+    readers.emplace_back([&, t]() {
+      PooledConnection connection(path);
+      names[t] = connection.database().connectionName();
+      QSqlQuery query(connection.database());
+      // Readers see the last committed state, not the open write
+      if (query.exec("SELECT SUM(value) FROM numbers") && query.next() &&
+          query.value(0).toInt() == 5050)
+        ++succeeded;
+    });
+  }
+  for (std::thread& reader : readers) reader.join();
+  QVERIFY(writer.database().commit());
+
+  QCOMPARE(succeeded.load(), kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    QVERIFY(names[t] != writer.database().connectionName());
+    for (int u = t + 1; u < kThreads; ++u) QVERIFY(names[t] != names[u]);
+  }
+}
+
+// Every thread's connection gets the per-connection settings, including
+// overrides from sqlite.ini beside the database
+void TestConnectionPool::testNewConnectionsTuned() {
+  QTemporaryDir tunedDir;
+  QSettings settings(tunedDir.filePath("sqlite.ini"), QSettings::IniFormat);
+  settings.setValue("sqlite/busy_timeout_ms", 1234);
+  settings.sync();
+  QString tunedPath = tunedDir.filePath("tuned.db");
+
+  auto pragma = [](QSqlDatabase& db, const QString& name) {
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA " + name) || !query.next()) return -1;
+    return query.value(0).toInt();
+  };
+
+  int busyTimeout = 0;
+  int tempStore = 0;
+  std::thread other([&]() {
+    PooledConnection connection(tunedPath);
+    busyTimeout = pragma(connection.database(), "busy_timeout");
+    tempStore = pragma(connection.database(), "temp_store");
+  });
+  other.join();
+  QCOMPARE(busyTimeout, 1234);
+  QCOMPARE(tempStore, 2);  // MEMORY
+
+  PooledConnection connection(path);
+  QCOMPARE(pragma(connection.database(), "busy_timeout"),
+           DatabaseTuning().busyTimeoutMs);
+}
+
+int main(int argc, char* argv[]) {
+  QApplication app(argc, argv);
+  TestConnectionPool test;
+  return QTest::qExec(&test, argc, argv);
+}
+#include "test_connectionpool.moc"
@@ -0,0 +1,73 @@
+#include <QApplication>
+#include <QtTest>
+#include <atomic>
+
+#include "databaseworker.h"
+
+class TestDatabaseWorker : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testJobsRunOffTheCallerThread();
+  void testJobsRunInOrder();
+  void testReplyDroppedForDestroyedContext();
+  void testDestructorRunsPendingJobs();
+};
+
+void TestDatabaseWorker::testJobsRunOffTheCallerThread() {
+  DatabaseWorker database;
+  QThread* jobThread = nullptr;
+  QThread* replyThread = nullptr;
+  database.post([](UserManager&) { return QThread::currentThread(); }, this,
+                [&](QThread* thread) {
+                  jobThread = thread;
+                  replyThread = QThread::currentThread();
+                });
+
+  QTRY_VERIFY(jobThread != nullptr);
+  QVERIFY(jobThread != QThread::currentThread());
+  QCOMPARE(replyThread, QThread::currentThread());
+}
+
+void TestDatabaseWorker::testJobsRunInOrder() {
+  DatabaseWorker database;
+  QList<int> order;
+  for (int i = 0; i < 20; ++i) {
+    database.post([i](UserManager&) { return i; }, this,
+                  [&order](int value) { order.append(value); });
+  }
+
+  QTRY_COMPARE(order.size(), 20);
+  for (int i = 0; i < 20; ++i) QCOMPARE(order[i], i);
+}
+
+void TestDatabaseWorker::testReplyDroppedForDestroyedContext() {
+  DatabaseWorker database;
+  QObject* context = new QObject();
+  bool replied = false;
+  database.post([](UserManager&) { return true; }, context,
+                [&replied](bool) { replied = true; });
+  delete context;
+
+  database.flush();
+  QTest::qWait(50);
+  QVERIFY(!replied);
+}
+
+void TestDatabaseWorker::testDestructorRunsPendingJobs() {
+  std::atomic<int> ran(0);
+  {
+    DatabaseWorker database;
+    for (int i = 0; i < 10; ++i) {
+      database.post([&ran](UserManager&) { ++ran; });
+    }
+  }
+  QCOMPARE(ran.load(), 10);
+}
+
+int main(int argc, char* argv[]) {
+  QApplication app(argc, argv);
+  TestDatabaseWorker test;
+  return QTest::qExec(&test, argc, argv);
+}
+#include "test_databaseworker.moc"
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "evaluator.h"
+#include "tictactoegame.h"
+
+namespace {
+EvalPosition makePosition(const char* layout) {
+  // 'x' own stone, 'o' opponent stone, '.' empty
+  EvalPosition position;
+  for (int i = 0; i < 9; ++i)
+    position.cells[i] = layout[i] == 'x' ? 1 : (layout[i] == 'o' ? -1 : 0);
+  return position;
+}
+
+std::string writeWeights(const std::string& name, const std::string& text) {
+  std::string path = testing::TempDir() + name;
+  std::ofstream(path) << text;
+  return path;
+}
+
+// Counts batch calls so tests can check leaves arrive in batches
+class CountingEvaluator : public Evaluator {
+ public:
+  int calls = 0;
+  int positions = 0;
+  void evaluateBatch(const EvalPosition* batch, int count,
+                     int* scores) override {
+    ++calls;
+    positions += count;
+    inner.evaluateBatch(batch, count, scores);
+  }
+
+ private:
+  LineEvaluator inner;
+};
+}  // namespace
+
+// Default evaluator favours the side with more open lines
+TEST(EvaluatorTest, LineEvaluator_CentreBeatsEdge) {
+  LineEvaluator evaluator;
+  EvalPosition positions[2] = {makePosition("....x...."),
+                               makePosition(".x.......")};
+  int scores[2];
+  evaluator.evaluateBatch(positions, 2, scores);
+  EXPECT_GT(scores[0], scores[1]);
+  EXPECT_GT(scores[1], 0);
+}
+
+// Linear weights: own centre stone worth 5, everything else 0
+TEST(EvaluatorTest, NetworkEvaluator_LinearWeights) {
+  std::string path = writeWeights(
+      "eval_linear.txt",
+      "# linear model\nhidden 0\nshift 2\n"
+      "0 0 0 0 20 0 0 0 0  0 0 0 0 -20 0 0 0 0\n0\n");
+  NetworkEvaluator evaluator;
+  ASSERT_TRUE(evaluator.loadFromFile(path));
+
+  EvalPosition positions[2] = {makePosition("....x...."),
+                               makePosition("....o....")};
+  int scores[2];
+  evaluator.evaluateBatch(positions, 2, scores);
+  EXPECT_EQ(scores[0], 5);
+  EXPECT_EQ(scores[1], -5);
+  std::remove(path.c_str());
+}
+
+// One hidden unit with ReLU clips negative activations
+TEST(EvaluatorTest, NetworkEvaluator_HiddenLayerRelu) {
+  std::string weights = "hidden 1\nshift 0\n";
+  for (int i = 0; i < 18; ++i) weights += (i < 9 ? "1 " : "-1 ");
+  weights += "\n0\n3\n0\n";
+  std::string path = writeWeights("eval_mlp.txt", weights);
+  NetworkEvaluator evaluator;
+  ASSERT_TRUE(evaluator.loadFromFile(path));
+
+  EvalPosition positions[2] = {makePosition("xx......."),
+                               makePosition("oo.......")};
+  int scores[2];
+  evaluator.evaluateBatch(positions, 2, scores);
+  EXPECT_EQ(scores[0], 6);
+  EXPECT_EQ(scores[1], 0);
+  std::remove(path.c_str());
+}
+
+// Truncated weight files are rejected
+TEST(EvaluatorTest, NetworkEvaluator_RejectsShortFile) {
+  std::string path = writeWeights("eval_bad.txt", "hidden 2\nshift 0\n1 2 3\n");
+  NetworkEvaluator evaluator;
+  EXPECT_FALSE(evaluator.loadFromFile(path));
+  EXPECT_FALSE(evaluator.isLoaded());
+  std::remove(path.c_str());
+}
+
+TEST(EvaluatorTest, NetworkEvaluator_RejectsOversizedHiddenLayer) {
+  std::string path = writeWeights(
+      "eval_big.txt",
+      "hidden " + std::to_string(NetworkEvaluator::kMaxHidden + 1) +
+          "\nshift 0\n");
+  NetworkEvaluator evaluator;
+  EXPECT_FALSE(evaluator.loadFromFile(path));
+  std::remove(path.c_str());
+}
+
+// The search sends frontier leaves in batches through the plugged evaluator
+TEST(EvaluatorTest, Search_UsesBatchedEvaluator) {
+  CountingEvaluator evaluator;
+  TicTacToeGame game;
+  game.setTranspositionTable(nullptr);
+  game.setEvaluator(&evaluator);
+  game.setStrength(0.5);
+  game.makeMove(1, 1, HUMAN);
+  game.getAIMove();
+
+  EXPECT_GT(evaluator.calls, 0);
+  EXPECT_GT(evaluator.positions, evaluator.calls);  // more than one per call
+}
+
+// Games sharing a table do not reuse scores from another evaluator
+TEST(EvaluatorTest, SharedTable_SeparatesEvaluators) {
+  TranspositionTable shared;
+  TranspositionTable fresh;
+  CountingEvaluator first;
+  CountingEvaluator second;
+  CountingEvaluator alone;
+  EXPECT_NE(first.tableSalt(), second.tableSalt());
+
+  auto search = [](TranspositionTable& table, CountingEvaluator& evaluator) {
+    TicTacToeGame game;
+    game.setTranspositionTable(&table);
+    game.setEvaluator(&evaluator);
+    game.setSeed(7);
+    game.setStrength(0.5);
+    game.makeMove(1, 1, HUMAN);
+    game.getAIMove();
+  };
+  search(shared, first);
+  search(shared, second);
+  search(fresh, alone);
+  EXPECT_EQ(second.positions, alone.positions);
+}
+
+// New weights invalidate entries cached under the old ones
+TEST(EvaluatorTest, NetworkEvaluator_LoadRenewsTableSalt) {
+  std::string path = writeWeights(
+      "eval_salt.txt",
+      "hidden 0\nshift 0\n0 0 0 0 1 0 0 0 0  0 0 0 0 -1 0 0 0 0\n0\n");
+  NetworkEvaluator evaluator;
+  uint64_t before = evaluator.tableSalt();
+  ASSERT_TRUE(evaluator.loadFromFile(path));
+  EXPECT_NE(evaluator.tableSalt(), before);
+  std::remove(path.c_str());
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+#include <QApplication>
+#include <QtTest>
+
+#include "gameanalyzer.h"
+
+class TestGameAnalyzer : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testBlunderDetected();
+  void testInaccuracyDetected();
+  void testInvalidGame();
+  void testQualityStringRoundTrip();
+  void testAnalyzeAllKeepsOrder();
+
+ private:
+  QVector<GameMove> parse(const QString& text);
+};
+
+QVector<GameMove> TestGameAnalyzer::parse(const QString& text) {
+  QVector<GameMove> moves;
+  GameValidator::parseMoves(text, moves);
+  return moves;
+}
+
+void TestGameAnalyzer::testBlunderDetected() {
+  // O answers the center with an edge, which loses by force; later O
+  // also fails to block the top row
+  GameAnalysis analysis =
+      GameAnalyzer::analyze(parse("0,0,1;1,1,2;0,1,1;2,2,2;0,2,1"));
+  QVERIFY(analysis.valid);
+  QCOMPARE(analysis.qualityString(), QString("BBBXB"));
+  QCOMPARE(analysis.accuracy, 80.0);
+
+  analysis = GameAnalyzer::analyze(parse("1,1,1;0,1,2"));
+  QCOMPARE(analysis.moves[1], MOVE_BLUNDER);
+}
+
+void TestGameAnalyzer::testInaccuracyDetected() {
+  // X's second move still wins, but more slowly than the best one
+  GameAnalysis analysis =
+      GameAnalyzer::analyze(parse("2,0,1;0,1,2;0,0,1;1,2,2;1,0,1"));
+  QVERIFY(analysis.valid);
+  QCOMPARE(analysis.qualityString(), QString("BXIXB"));
+  QCOMPARE(analysis.accuracy, 50.0);
+}
+
+void TestGameAnalyzer::testInvalidGame() {
+  QVERIFY(!GameAnalyzer::analyze(parse("0,0,1;0,0,2")).valid);
+  QVERIFY(!GameAnalyzer::analyze(QVector<GameMove>()).valid);
+
+  StoredGame game;
+  game.id = 7;
+  game.movesData = "garbage";
+  GameAnalysis analysis = GameAnalyzer::analyze(game);
+  QVERIFY(!analysis.valid);
+  QCOMPARE(analysis.gameId, qint64(7));
+}
+
+void TestGameAnalyzer::testQualityStringRoundTrip() {
+  GameAnalysis analysis;
+  analysis.moves = {MOVE_BEST, MOVE_BLUNDER, MOVE_INACCURACY};
+  QCOMPARE(analysis.qualityString(), QString("BXI"));
+  QCOMPARE(GameAnalysis::qualityFromString("BXI"), analysis.moves);
+}
+
+void TestGameAnalyzer::testAnalyzeAllKeepsOrder() {
+  QVector<StoredGame> games;
+  for (int i = 0; i < 200; ++i) {
+    StoredGame game;
+    game.id = 1000 + i;
+    game.movesData = (i % 2) ? "1,1,1;0,1,2" : "0,0,1;0,0,2";
+    games.append(game);
+  }
+
+  QVector<GameAnalysis> results = GameAnalyzer::analyzeAll(games, 4);
+  QCOMPARE(results.size(), 200);
+  for (int i = 0; i < 200; ++i) {
+    QCOMPARE(results[i].gameId, qint64(1000 + i));
+    QCOMPARE(results[i].valid, i % 2 == 1);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  QApplication app(argc, argv);
+  TestGameAnalyzer test;
+  return QTest::qExec(&test, argc, argv);
+}
+#include "test_gameanalyzer.moc"
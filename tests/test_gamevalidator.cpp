@@ -0,0 +1,134 @@
+#include <QApplication>
+#include <QtTest>
+
+#include "gamevalidator.h"
+
+class TestGameValidator : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void testParseMoves();
+  void testParseRejectsMalformed();
+  void testValidGames();
+  void testIllegalMoves();
+  void testMoveAfterEnd();
+  void testResultMismatch();
+  void testValidateAllMatchesSingleThread();
+
+ private:
+  // X wins on the top row at move 5
+  const QString xWins = "0,0,1;1,1,2;0,1,1;2,2,2;0,2,1";
+  const QString tie = "0,0,1;0,1,2;0,2,1;1,1,2;1,0,1;1,2,2;2,1,1;2,0,2;2,2,1";
+
+  StoredGame makeGame(qint64 id, const QString& moves, const QString& result,
+                      const QString& symbol);
+};
+
+StoredGame TestGameValidator::makeGame(qint64 id, const QString& moves,
+                                       const QString& result,
+                                       const QString& symbol) {
+  StoredGame game;
+  game.id = id;
+  game.username = "validator";
+  game.movesData = moves;
+  game.result = result;
+  game.playerSymbol = symbol;
+  return game;
+}
+
+void TestGameValidator::testParseMoves() {
+  QVector<GameMove> moves;
+  QVERIFY(GameValidator::parseMoves(xWins, moves));
+  QCOMPARE(moves.size(), 5);
+  QCOMPARE(moves[3].row, 2);
+  QCOMPARE(moves[3].col, 2);
+  QCOMPARE(moves[3].player, 2);
+}
+
+void TestGameValidator::testParseRejectsMalformed() {
+  QVector<GameMove> moves;
+  QVERIFY(!GameValidator::parseMoves("0,0", moves));
+  QVERIFY(!GameValidator::parseMoves("0,0,1;x", moves));
+  QVERIFY(!GameValidator::parseMoves("0,0,1,2", moves));
+  QVERIFY(!GameValidator::parseMoves("0;0;1", moves));
+  QCOMPARE(GameValidator::validate(makeGame(1, "a,b,c", "Won", "X")),
+           GAME_MALFORMED);
+}
+
+void TestGameValidator::testValidGames() {
+  QCOMPARE(GameValidator::validate(makeGame(1, xWins, "Won", "X")), GAME_OK);
+  QCOMPARE(GameValidator::validate(makeGame(2, xWins, "Lost", "O")), GAME_OK);
+  QCOMPARE(GameValidator::validate(makeGame(3, tie, "Tie", "O")), GAME_OK);
+  QCOMPARE(GameValidator::validate(makeGame(4, "", "Won", "X")),
+           GAME_NO_MOVES);
+}
+
+void TestGameValidator::testIllegalMoves() {
+  int index = -1;
+  QCOMPARE(GameValidator::validate(makeGame(1, "0,0,1;0,0,2", "Won", "X"),
+                                   &index),
+           GAME_ILLEGAL_MOVE);
+  QCOMPARE(index, 1);
+
+  // O may not move first, nor X twice in a row
+  QCOMPARE(GameValidator::validate(makeGame(2, "0,0,2", "Won", "X"), &index),
+           GAME_ILLEGAL_MOVE);
+  QCOMPARE(index, 0);
+  QCOMPARE(GameValidator::validate(makeGame(3, "0,0,1;0,1,1", "Won", "X")),
+           GAME_ILLEGAL_MOVE);
+  QCOMPARE(GameValidator::validate(makeGame(4, "3,0,1", "Won", "X")),
+           GAME_ILLEGAL_MOVE);
+}
+
+void TestGameValidator::testMoveAfterEnd() {
+  int index = -1;
+  QCOMPARE(GameValidator::validate(
+               makeGame(1, xWins + ";2,0,2", "Won", "X"), &index),
+           GAME_MOVE_AFTER_END);
+  QCOMPARE(index, 5);
+}
+
+void TestGameValidator::testResultMismatch() {
+  QCOMPARE(GameValidator::validate(makeGame(1, xWins, "Lost", "X")),
+           GAME_RESULT_MISMATCH);
+  QCOMPARE(GameValidator::validate(makeGame(2, xWins, "Tie", "X")),
+           GAME_RESULT_MISMATCH);
+  QCOMPARE(GameValidator::validate(makeGame(3, tie, "Won", "X")),
+           GAME_RESULT_MISMATCH);
+  // Unfinished games are never recorded
+  QCOMPARE(GameValidator::validate(makeGame(4, "0,0,1;1,1,2", "Won", "X")),
+           GAME_RESULT_MISMATCH);
+}
+
+void TestGameValidator::testValidateAllMatchesSingleThread() {
+  const QString samples[][3] = {{xWins, "Won", "X"},
+                                {tie, "Tie", "X"},
+                                {"0,0,1;0,0,2", "Won", "X"},
+                                {xWins, "Tie", "O"},
+                                {"", "Lost", "O"}};
+  QVector<StoredGame> games;
+  for (int i = 0; i < 5000; ++i) {
+    const QString* sample = samples[i % 5];
+    games.append(makeGame(i, sample[0], sample[1], sample[2]));
+  }
+
+  ValidationReport single = GameValidator::validateAll(games, 1);
+  ValidationReport threaded = GameValidator::validateAll(games, 4);
+  QCOMPARE(single.gamesChecked, 5000);
+  QCOMPARE(single.counts[GAME_OK], 2000);
+  QCOMPARE(single.counts[GAME_NO_MOVES], 1000);
+  QCOMPARE(single.counts[GAME_ILLEGAL_MOVE], 1000);
+  QCOMPARE(single.counts[GAME_RESULT_MISMATCH], 1000);
+  QCOMPARE(threaded.issues.size(), 2000);
+  for (int i = 0; i < threaded.issues.size(); ++i) {
+    QCOMPARE(threaded.issues[i].id, single.issues[i].id);
+    QCOMPARE(threaded.issues[i].check, single.issues[i].check);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  QApplication app(argc, argv);
+  TestGameValidator test;
+  return QTest::qExec(&test, argc, argv);
+}
+#include "test_gamevalidator.moc"
@@ -481,7 +481,7 @@ void TestMainWindow::testGameReplayInterface() {
            QString("🎮 Tic Tac Toe - Sign In to Play!"));
 
   // Check for replay controls
-  QListWidget* gameList = mainWindow->findChild<QListWidget*>();
+  QListView* gameList = mainWindow->findChild<QListView*>();
   QSlider* speedSlider = mainWindow->findChild<QSlider*>();
 
   QVERIFY(gameList != nullptr);
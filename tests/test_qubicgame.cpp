@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "qubicgame.h"
+
+// The cube has exactly 76 winning lines of four cells each
+TEST(QubicTest, LineTable_Has76FourCellLines) {
+  const uint64_t* lines = QubicGame::lineMasks();
+  for (int i = 0; i < QubicGame::kLineCount; ++i) {
+    EXPECT_EQ(__builtin_popcountll(lines[i]), 4);
+    for (int j = i + 1; j < QubicGame::kLineCount; ++j)
+      EXPECT_NE(lines[i], lines[j]);
+  }
+}
+
+// Moves alternate and occupied cells are rejected
+TEST(QubicTest, MakeMove_AlternatesPlayers) {
+  QubicGame game;
+  EXPECT_TRUE(game.makeMove(0));
+  EXPECT_EQ(game.getCell(0), HUMAN);
+  EXPECT_EQ(game.getCurrentPlayer(), AI);
+  EXPECT_FALSE(game.makeMove(0));
+  EXPECT_FALSE(game.makeMove(64));
+}
+
+// Space diagonal wins
+TEST(QubicTest, SpaceDiagonal_Wins) {
+  QubicGame game;
+  for (int i = 0; i < 4; ++i) {
+    game.makeMove(QubicGame::cellIndex(i, i, i));   // X
+    if (i < 3) game.makeMove(QubicGame::cellIndex(0, 3, i));  // O
+  }
+  EXPECT_EQ(game.getWinner(), HUMAN);
+  EXPECT_TRUE(game.isGameOver());
+  EXPECT_FALSE(game.makeMove(QubicGame::cellIndex(3, 0, 0)));
+}
+
+// Undo restores stones, hash and turn
+TEST(QubicTest, Undo_RestoresPosition) {
+  QubicGame game;
+  uint64_t empty = game.getHash();
+  game.makeMove(5);
+  game.makeMove(21);
+  EXPECT_TRUE(game.undoMove());
+  EXPECT_TRUE(game.undoMove());
+  EXPECT_EQ(game.getHash(), empty);
+  EXPECT_EQ(game.getCurrentPlayer(), HUMAN);
+  EXPECT_FALSE(game.undoMove());
+}
+
+// Search completes an open line of three
+TEST(QubicTest, BestMove_TakesWin) {
+  QubicGame game;
+  game.makeMove(QubicGame::cellIndex(1, 0, 0));  // X
+  game.makeMove(QubicGame::cellIndex(2, 2, 0));  // O
+  game.makeMove(QubicGame::cellIndex(1, 0, 1));  // X
+  game.makeMove(QubicGame::cellIndex(2, 2, 1));  // O
+  game.makeMove(QubicGame::cellIndex(1, 0, 2));  // X
+
+  // O must block (1,0,3) or lose
+  EXPECT_EQ(game.getBestMove(4), QubicGame::cellIndex(1, 0, 3));
+
+  game.makeMove(QubicGame::cellIndex(3, 3, 3));  // O ignores the threat
+  EXPECT_EQ(game.getBestMove(4), QubicGame::cellIndex(1, 0, 3));
+}
+
+// Node budget caps the search
+TEST(QubicTest, BestMove_RespectsNodeBudget) {
+  QubicGame game;
+  int move = game.getBestMove(8, 5000);
+  EXPECT_TRUE(game.isLegalMove(move));
+  EXPECT_LE(game.getLastSearchNodes(), 5001);
+}
+
+// A budgeted search does not depend on searches other games ran before
+TEST(QubicTest, BestMove_IndependentOfOtherGames) {
+  QubicGame first;
+  int move = first.getBestMove(8, 5000);
+  long nodes = first.getLastSearchNodes();
+
+  QubicGame second;
+  EXPECT_EQ(second.getBestMove(8, 5000), move);
+  EXPECT_EQ(second.getLastSearchNodes(), nodes);
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
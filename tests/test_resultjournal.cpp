@@ -0,0 +1,151 @@
+#include <QApplication>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "resultjournal.h"
+
+class TestResultJournal : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void init();
+  void testEntriesSurviveReopen();
+  void testTornTailIgnored();
+  void testDiscardKeepsLaterEntries();
+  void testAppliedEntriesDroppedOnOpen();
+  void testAppendNeedsOpenJournal();
+
+ private:
+  JournalEntry gameEntry(const QString& username, const QString& opponent);
+
+  QTemporaryDir dir;
+  QString path;
+};
+
+void TestResultJournal::init() {
+  path = dir.filePath("results.journal");
+  QFile::remove(path);
+}
+
+JournalEntry TestResultJournal::gameEntry(const QString& username,
+                                          const QString& opponent) {
+  JournalEntry entry;
+  entry.username = username;
+  entry.won = 1;
+  entry.hasGame = true;
+  entry.game = GameRecord(opponent, "Won", "PvAI Hard", "X");
+  entry.game.moves = {GameMove(0, 0, 1), GameMove(1, 1, 2),
+                      GameMove(0, 1, 1)};
+  return entry;
+}
+
+void TestResultJournal::testEntriesSurviveReopen() {
+  ResultJournal journal;
+  QVERIFY(journal.open(path, 0));
+  JournalEntry first = gameEntry("alice", "AI");
+  JournalEntry second;
+  second.username = "alice";
+  second.tied = 1;
+  QVERIFY(journal.append(first));
+  QVERIFY(journal.append(second));
+  journal.close();
+
+  QVERIFY(journal.open(path, 0));
+  QCOMPARE(journal.entries().size(), 2);
+  const JournalEntry& game = journal.entries()[0];
+  QCOMPARE(game.sequence, qint64(1));
+  QCOMPARE(game.username, QString("alice"));
+  QCOMPARE(game.won, 1);
+  QVERIFY(game.hasGame);
+  QCOMPARE(game.game.opponent, QString("AI"));
+  QCOMPARE(game.game.moves.size(), 3);
+  QCOMPARE(game.game.moves[1].player, 2);
+  QCOMPARE(journal.entries()[1].tied, 1);
+  QVERIFY(!journal.entries()[1].hasGame);
+
+  // Sequences carry on after the entries already on disk
+  JournalEntry third = gameEntry("alice", "Bob");
+  QVERIFY(journal.append(third));
+  QCOMPARE(third.sequence, qint64(3));
+}
+
+void TestResultJournal::testTornTailIgnored() {
+  ResultJournal journal;
+  QVERIFY(journal.open(path, 0));
+  JournalEntry first = gameEntry("alice", "AI");
+  JournalEntry second = gameEntry("alice", "Bob");
+  QVERIFY(journal.append(first));
+  QVERIFY(journal.append(second));
+  journal.close();
+
+  // A crash in the middle of the second write
+  QFile file(path);
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.resize(file.size() - 5));
+  file.close();
+
+  QVERIFY(journal.open(path, 0));
+  QCOMPARE(journal.entries().size(), 1);
+  QCOMPARE(journal.entries()[0].game.opponent, QString("AI"));
+
+  JournalEntry third = gameEntry("alice", "Carol");
+  QVERIFY(journal.append(third));
+  journal.close();
+  QVERIFY(journal.open(path, 0));
+  QCOMPARE(journal.entries().size(), 2);
+  QCOMPARE(journal.entries()[1].game.opponent, QString("Carol"));
+}
+
+void TestResultJournal::testDiscardKeepsLaterEntries() {
+  ResultJournal journal;
+  QVERIFY(journal.open(path, 0));
+  for (int i = 0; i < 4; ++i) {
+    JournalEntry entry = gameEntry("alice", QString("Opponent%1").arg(i));
+    QVERIFY(journal.append(entry));
+  }
+
+  QVERIFY(journal.discardThrough(2));
+  QCOMPARE(journal.entries().size(), 2);
+  journal.close();
+
+  QVERIFY(journal.open(path, 0));
+  QCOMPARE(journal.entries().size(), 2);
+  QCOMPARE(journal.entries()[0].sequence, qint64(3));
+  QCOMPARE(journal.entries()[0].game.opponent, QString("Opponent2"));
+}
+
+void TestResultJournal::testAppliedEntriesDroppedOnOpen() {
+  ResultJournal journal;
+  QVERIFY(journal.open(path, 10));
+  for (int i = 0; i < 3; ++i) {
+    JournalEntry entry = gameEntry("alice", QString("Opponent%1").arg(i));
+    QVERIFY(journal.append(entry));
+  }
+  QCOMPARE(journal.lastSequence(), qint64(13));
+  journal.close();
+
+  // The database committed the first two before the crash
+  QVERIFY(journal.open(path, 12));
+  QCOMPARE(journal.entries().size(), 1);
+  QCOMPARE(journal.entries()[0].sequence, qint64(13));
+  QCOMPARE(journal.lastSequence(), qint64(13));
+}
+
+void TestResultJournal::testAppendNeedsOpenJournal() {
+  ResultJournal owner;
+  QVERIFY(owner.open(path, 0));
+  ResultJournal second;
+  QVERIFY(!second.open(path, 0));  // already in use
+
+  JournalEntry entry = gameEntry("alice", "Bob");
+  QVERIFY(!second.append(entry));
+  QVERIFY(second.isEmpty());
+  QCOMPARE(second.lastSequence(), qint64(0));
+}
+
+int main(int argc, char* argv[]) {
+  QApplication app(argc, argv);
+  TestResultJournal test;
+  return QTest::qExec(&test, argc, argv);
+}
+#include "test_resultjournal.moc"
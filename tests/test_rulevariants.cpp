@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "rulevariants.h"
+
+// Gravity: stones stack from the bottom of the chosen column
+TEST(GravityTest, Drop_LandsOnLowestEmptyRow) {
+  GravityFourGame game;
+  EXPECT_TRUE(game.makeMove(3));
+  EXPECT_TRUE(game.makeMove(3));
+  EXPECT_EQ(game.getCell(0, 3), HUMAN);
+  EXPECT_EQ(game.getCell(1, 3), AI);
+  EXPECT_EQ(game.getCell(2, 3), NONE);
+}
+
+// Gravity: a full column is no longer a legal move
+TEST(GravityTest, Drop_FullColumnRejected) {
+  GravityFourGame game;
+  for (int i = 0; i < 6; ++i) EXPECT_TRUE(game.makeMove(0));
+  EXPECT_FALSE(game.makeMove(0));
+  EXPECT_FALSE(game.makeMove(7));
+
+  int moves[GravityFourGame::kCells];
+  EXPECT_EQ(game.generateMoves(moves), 6);
+}
+
+// Gravity: four in a row wins for the player who made it
+TEST(GravityTest, FourInRow_Wins) {
+  GravityFourGame game;
+  for (int col = 0; col < 3; ++col) {
+    game.makeMove(col);  // X on the bottom row
+    game.makeMove(col);  // O on top
+  }
+  game.makeMove(3);
+  EXPECT_EQ(game.getWinner(), HUMAN);
+  EXPECT_TRUE(game.isGameOver());
+}
+
+// Gravity: the search blocks an open three
+TEST(GravityTest, BestMove_BlocksThree) {
+  GravityFourGame game;
+  game.makeMove(1);  // X
+  game.makeMove(1);  // O
+  game.makeMove(2);  // X
+  game.makeMove(2);  // O
+  game.makeMove(3);  // X threatens columns 0 and 4
+  game.makeMove(6);  // O wastes a move
+  // X wins at once
+  int move = game.getBestMove(4);
+  EXPECT_TRUE(move == 0 || move == 4);
+}
+
+// Misère: completing three in a row loses
+TEST(MisereTest, ThreeInRow_Loses) {
+  MisereTicTacToe game;
+  game.makeMove(0);  // X
+  game.makeMove(3);  // O
+  game.makeMove(1);  // X
+  game.makeMove(4);  // O
+  game.makeMove(8);  // X
+  game.makeMove(5);  // O completes the middle row
+  EXPECT_EQ(game.getWinner(), HUMAN);
+}
+
+// Misère: the search avoids completing its own line
+TEST(MisereTest, BestMove_AvoidsOwnLine) {
+  MisereTicTacToe game;
+  game.makeMove(0);  // X
+  game.makeMove(4);  // O
+  game.makeMove(1);  // X: playing cell 2 would complete the bottom row
+  game.makeMove(8);  // O
+  EXPECT_NE(game.getBestMove(9), 2);
+}
+
+// Misère 3x3 is a draw with perfect play
+TEST(MisereTest, Solve_EmptyBoardIsDraw) {
+  MisereTicTacToe game;
+  game.getBestMove(9);
+  EXPECT_EQ(game.getLastScore(), 0);
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
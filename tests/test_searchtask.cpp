@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "searchtask.h"
+#include "tictactoegame.h"
+#include "transpositiontable.h"
+
+namespace {
+void play(TicTacToeGame& game, const int* cells, int count) {
+  Player player = HUMAN;
+  for (int i = 0; i < count; ++i) {
+    game.makeMove(cells[i] / 3, cells[i] % 3, player);
+    player = player == HUMAN ? AI : HUMAN;
+  }
+}
+}  // namespace
+
+TEST(SearchTaskTest, SlicedSearchMatchesSingleRun) {
+  const int opening[] = {4, 0};
+  for (double strength : {0.25, 0.5, 0.75, 1.0}) {
+    TicTacToeGame whole;
+    play(whole, opening, 2);
+    whole.setStrength(strength);
+    whole.setSeed(11);
+    whole.setTranspositionTable(nullptr);
+    SearchTask full(whole, HUMAN);
+    EXPECT_TRUE(full.step(LONG_MAX));
+
+    TicTacToeGame sliced;
+    play(sliced, opening, 2);
+    sliced.setStrength(strength);
+    sliced.setSeed(11);
+    sliced.setTranspositionTable(nullptr);
+    SearchTask task(sliced, HUMAN);
+    int slices = 0;
+    while (!task.step(7)) ++slices;
+
+    EXPECT_EQ(full.getMove(), task.getMove());
+    EXPECT_EQ(full.getNodes(), task.getNodes());
+    EXPECT_EQ(full.getRootScores(), task.getRootScores());
+    EXPECT_GT(slices, 0);
+  }
+}
+
+TEST(SearchTaskTest, StepRespectsSliceSize) {
+  TicTacToeGame game;
+  game.setStrength(1.0);
+  game.setTranspositionTable(nullptr);
+  SearchTask task(game, HUMAN);
+  long previous = 0;
+  while (!task.step(100)) {
+    // A frontier batch may overshoot by at most one node per empty cell
+    EXPECT_LE(task.getNodes() - previous, 100 + 9);
+    previous = task.getNodes();
+  }
+  EXPECT_NE(task.getMove().first, -1);
+}
+
+TEST(SearchTaskTest, CallerGameIsUntouched) {
+  const int cells[] = {0, 4, 8};
+  TicTacToeGame game;
+  play(game, cells, 3);
+  uint64_t hash = game.getHash();
+  Player current = game.getCurrentPlayer();
+
+  SearchTask task(game, AI);
+  task.step(50);
+  EXPECT_EQ(game.getHash(), hash);
+  EXPECT_EQ(game.getMoveCount(), 3);
+  EXPECT_EQ(game.getCurrentPlayer(), current);
+}
+
+TEST(SearchTaskTest, ExactModeScoresEveryRootMove) {
+  // X to move wins at once by completing the top row
+  const int cells[] = {0, 3, 1, 6, 4, 8};
+  TicTacToeGame game;
+  play(game, cells, 6);
+  SearchTask task(game, HUMAN, true);
+  task.step(LONG_MAX);
+
+  ASSERT_EQ(task.getRootMoves().size(), 3u);
+  EXPECT_EQ(task.getMove(), std::make_pair(0, 2));
+  EXPECT_EQ(task.getScore(), TicTacToeGame::kWinScore - 1);
+  EXPECT_EQ(task.getScore(), game.solvePosition(HUMAN));
+}
+
+TEST(SearchTaskTest, FinishedPositionHasNoMove) {
+  const int cells[] = {0, 3, 1, 4, 2};
+  TicTacToeGame game;
+  play(game, cells, 5);
+  SearchTask task(game, AI);
+  EXPECT_TRUE(task.isFinished());
+  EXPECT_EQ(task.getMove(), std::make_pair(-1, -1));
+}
+
+TEST(SearchTaskTest, MultiPVMatchesExactRootScores) {
+  const int cells[] = {4, 1};
+  TicTacToeGame game;
+  play(game, cells, 2);
+
+  TicTacToeGame reference = game;  // own table, so nothing is reused
+  SearchTask full(reference, HUMAN, true);
+  full.step(LONG_MAX);
+  std::vector<int> expected = full.getRootScores();
+  std::sort(expected.rbegin(), expected.rend());
+
+  std::vector<SearchLine> lines = game.analyzePosition(HUMAN, 3);
+  ASSERT_EQ(lines.size(), 3u);
+  for (int i = 0; i < 3; ++i) EXPECT_EQ(lines[i].score, expected[i]);
+  EXPECT_EQ(lines[0].score, game.solvePosition(HUMAN));
+}
+
+TEST(SearchTaskTest, PrincipalVariationsReachTheScore) {
+  const int cells[] = {4, 1};
+  TicTacToeGame game;
+  play(game, cells, 2);
+  std::vector<SearchLine> lines = game.analyzePosition(HUMAN, 7);
+  ASSERT_EQ(lines.size(), 7u);
+
+  for (const SearchLine& line : lines) {
+    // Play the line out: a forced win ends in a win after the stated plies
+    TicTacToeGame replay = game;
+    Player player = HUMAN;
+    for (int cell : line.moves) {
+      ASSERT_TRUE(replay.makeMove(cell / 3, cell % 3, player));
+      player = player == HUMAN ? AI : HUMAN;
+    }
+    if (line.score > 0) {
+      EXPECT_TRUE(replay.checkWin(HUMAN));
+      EXPECT_EQ(int(line.moves.size()), TicTacToeGame::kWinScore - line.score);
+    } else if (line.score == 0) {
+      EXPECT_TRUE(replay.isBoardFull());
+      EXPECT_FALSE(replay.checkWin(HUMAN) || replay.checkWin(AI));
+    }
+  }
+}
+
+TEST(SearchTaskTest, MultiPVWindowsSaveNodes) {
+  TicTacToeGame game;
+  game.setTranspositionTable(nullptr);
+  SearchTask all(game, HUMAN, true);
+  all.step(LONG_MAX);
+
+  SearchTask top(game, HUMAN, true);
+  top.setMultiPV(2);
+  top.step(LONG_MAX);
+  ASSERT_EQ(top.getLines().size(), 2u);
+  EXPECT_LT(top.getNodes(), all.getNodes());
+  EXPECT_EQ(top.getLines()[0].score, 0);
+  EXPECT_EQ(top.getLines()[0].moves.size(), 1u);  // no table, no replies
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
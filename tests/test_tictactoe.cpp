@@ -197,96 +197,6 @@ TEST(GameLogicTest, SwitchPlayer_TogglesCorrectly) {
   EXPECT_EQ(game.getCurrentPlayer(), HUMAN);
 }
 
-// Test for easyAI function
-// Test 1: AI returns a valid move on an empty board
-TEST(AIEasyTest, EasyAI_EmptyBoard_ReturnsValidMove) {
-  TicTacToeGame game;
-  std::pair<int, int> move = game.test_easyAI();
-
-  EXPECT_GE(move.first, 0);
-  EXPECT_LT(move.first, 3);
-  EXPECT_GE(move.second, 0);
-  EXPECT_LT(move.second, 3);
-  EXPECT_EQ(game.getCell(move.first, move.second), NONE);
-}
-
-// Test 2: AI avoids filled cells
-TEST(AIEasyTest, EasyAI_AvoidsFilledCells) {
-  TicTacToeGame game;
-
-  // Fill some cells
-  game.makeMove(0, 0, HUMAN);
-  game.makeMove(0, 1, AI);
-  game.makeMove(0, 2, HUMAN);
-
-  std::pair<int, int> move = game.test_easyAI();
-
-  // Make sure the AI did not return a filled position
-  EXPECT_NE(move, std::make_pair(0, 0));
-  EXPECT_NE(move, std::make_pair(0, 1));
-  EXPECT_NE(move, std::make_pair(0, 2));
-  EXPECT_EQ(game.getCell(move.first, move.second), NONE);
-}
-
-// Test 3: AI returns (-1, -1) when board is full
-TEST(AIEasyTest, EasyAI_FullBoard_ReturnsInvalidMove) {
-  TicTacToeGame game;
-
-  // Fill entire board
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j) game.makeMove(i, j, HUMAN);
-
-  std::pair<int, int> move = game.test_easyAI();
-  EXPECT_EQ(move.first, -1);
-  EXPECT_EQ(move.second, -1);
-}
-
-// Test for mediumAI function
-// Test 1: AI should take winning move
-TEST(AIMediumTest, MediumAI_WinsWhenPossible) {
-  TicTacToeGame game;
-
-  // Set board so AI can win at (0, 2)
-  game.makeMove(0, 0, AI);
-  game.makeMove(0, 1, AI);
-
-  std::pair<int, int> move = game.test_mediumAI();
-
-  EXPECT_EQ(move.first, 0);
-  EXPECT_EQ(move.second, 2);
-}
-
-// Test 2: AI should block human from winning
-TEST(AIMediumTest, MediumAI_BlocksHumanWin) {
-  TicTacToeGame game;
-
-  // HUMAN can win at (2, 2)
-  game.makeMove(2, 0, HUMAN);
-  game.makeMove(2, 1, HUMAN);
-
-  std::pair<int, int> move = game.test_mediumAI();
-
-  EXPECT_EQ(move.first, 2);
-  EXPECT_EQ(move.second, 2);
-}
-
-// Test 3: No threat or win → random move
-TEST(AIMediumTest, MediumAI_RandomWhenNoThreat) {
-  TicTacToeGame game;
-
-  // No one is winning yet
-  game.makeMove(0, 0, HUMAN);
-  game.makeMove(1, 1, AI);
-
-  std::pair<int, int> move = game.test_mediumAI();
-
-  EXPECT_GE(move.first, 0);
-  EXPECT_LT(move.first, 3);
-  EXPECT_GE(move.second, 0);
-  EXPECT_LT(move.second, 3);
-  EXPECT_EQ(game.getCell(move.first, move.second), NONE);
-}
-
 // Test for getBestMove function
 //  AI should take winning move
 TEST(AIHardTest, GetBestMove_AIWinsWhenPossible) {
@@ -496,6 +406,115 @@ TEST(GetAIMoveTest, Difficulty3_HardMode_WinsIfPossible) {
   EXPECT_EQ(move.second, 2);
 }
 
+// Tests for strength-scaled search
+// Same seed and strength must reproduce the same move
+TEST(StrengthTest, SameSeed_ReproducesMove) {
+  for (int seed = 0; seed < 20; ++seed) {
+    TicTacToeGame first;
+    TicTacToeGame second;
+    first.setSeed(seed);
+    second.setSeed(seed);
+    first.setStrength(0.3);
+    second.setStrength(0.3);
+
+    EXPECT_EQ(first.getAIMove(), second.getAIMove());
+  }
+}
+
+// Search never visits more nodes than the budget for its strength
+TEST(StrengthTest, NodeBudget_IsRespected) {
+  for (double strength : {0.0, 0.25, 0.5, 0.75, 1.0}) {
+    TicTacToeGame game;
+    game.setStrength(strength);
+    game.getAIMove();
+    EXPECT_LE(game.getLastSearchNodes(),
+              TicTacToeGame::nodeBudgetForStrength(strength) + 1);
+  }
+}
+
+// Budget grows monotonically with strength
+TEST(StrengthTest, NodeBudget_ScalesWithStrength) {
+  EXPECT_LT(TicTacToeGame::nodeBudgetForStrength(0.0),
+            TicTacToeGame::nodeBudgetForStrength(0.5));
+  EXPECT_LT(TicTacToeGame::nodeBudgetForStrength(0.5),
+            TicTacToeGame::nodeBudgetForStrength(1.0));
+}
+
+// Tests for the undo/redo move stack
+// Undo restores the cell, hash and current player
+TEST(MoveStackTest, Undo_RestoresPosition) {
+  TicTacToeGame game;
+  uint64_t emptyHash = game.getHash();
+
+  game.makeMove(1, 1, HUMAN);
+  game.switchPlayer();
+  EXPECT_NE(game.getHash(), emptyHash);
+
+  EXPECT_TRUE(game.undoMove());
+  EXPECT_EQ(game.getCell(1, 1), NONE);
+  EXPECT_EQ(game.getHash(), emptyHash);
+  EXPECT_EQ(game.getCurrentPlayer(), HUMAN);
+  EXPECT_FALSE(game.undoMove());
+}
+
+// Undoing a winning move clears the win
+TEST(MoveStackTest, Undo_ClearsWin) {
+  TicTacToeGame game;
+  game.makeMove(0, 0, AI);
+  game.makeMove(0, 1, AI);
+  game.makeMove(0, 2, AI);
+  EXPECT_TRUE(game.checkWin(AI));
+
+  game.undoMove();
+  EXPECT_FALSE(game.checkWin(AI));
+}
+
+// Redo reapplies undone moves; a new move discards them
+TEST(MoveStackTest, Redo_ReappliesAndIsClearedByNewMove) {
+  TicTacToeGame game;
+  game.makeMove(0, 0, HUMAN);
+  game.switchPlayer();
+  uint64_t afterMove = game.getHash();
+
+  game.undoMove();
+  EXPECT_TRUE(game.canRedo());
+  EXPECT_TRUE(game.redoMove());
+  EXPECT_EQ(game.getCell(0, 0), HUMAN);
+  EXPECT_EQ(game.getHash(), afterMove);
+  EXPECT_EQ(game.getCurrentPlayer(), AI);
+
+  game.undoMove();
+  game.makeMove(2, 2, HUMAN);
+  EXPECT_FALSE(game.canRedo());
+}
+
+// Same position reached by different move orders hashes identically
+TEST(MoveStackTest, Hash_IndependentOfMoveOrder) {
+  TicTacToeGame first;
+  first.makeMove(0, 0, HUMAN);
+  first.makeMove(1, 1, AI);
+
+  TicTacToeGame second;
+  second.makeMove(1, 1, AI);
+  second.makeMove(0, 0, HUMAN);
+
+  EXPECT_EQ(first.getHash(), second.getHash());
+}
+
+// Search leaves the position untouched
+TEST(MoveStackTest, Search_LeavesPositionUnchanged) {
+  TicTacToeGame game;
+  game.makeMove(0, 0, HUMAN);
+  uint64_t before = game.getHash();
+
+  game.test_getBestMove(AI);
+  game.setDifficulty(3);
+  game.getAIMove();
+
+  EXPECT_EQ(game.getHash(), before);
+  EXPECT_EQ(game.getMoveCount(), 1);
+}
+
 int main() {
   ::testing::InitGoogleTest();  // initialze googletest
   return RUN_ALL_TESTS();       // excute all tests above main
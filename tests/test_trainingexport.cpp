@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "trainingexport.h"
+
+namespace {
+std::string tempPath() {
+  std::string path = testing::TempDir() + "tictactoe_training.bin";
+  std::remove(path.c_str());
+  return path;
+}
+}  // namespace
+
+// Records survive encoding to the fixed-width wire format
+TEST(TrainingExportTest, Record_RoundTrip) {
+  TrainingRecord record{12345, 2, 7, -996, -1, 5, 99};
+  unsigned char buffer[TrainingExporter::kRecordSize];
+  TrainingExporter::encodeRecord(record, buffer);
+  TrainingRecord decoded = TrainingExporter::decodeRecord(buffer);
+
+  EXPECT_EQ(decoded.board, 12345);
+  EXPECT_EQ(decoded.sideToMove, 2);
+  EXPECT_EQ(decoded.bestMove, 7);
+  EXPECT_EQ(decoded.value, -996);
+  EXPECT_EQ(decoded.result, -1);
+  EXPECT_EQ(decoded.ply, 5);
+  EXPECT_EQ(decoded.gameId, 99u);
+}
+
+// Every rotation and reflection of a position shares one canonical form
+TEST(TrainingExportTest, Canonicalize_SymmetricPositionsAgree) {
+  int corner[9] = {1, 0, 0, 0, 2, 0, 0, 0, 0};
+  int otherCorner[9] = {0, 0, 0, 0, 2, 0, 0, 0, 1};
+  int move = -1;
+  int otherMove = -1;
+  uint16_t a = TrainingExporter::canonicalize(corner, 1, &move);
+  uint16_t b = TrainingExporter::canonicalize(otherCorner, 7, &otherMove);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(move, otherMove);
+}
+
+// Self-play writes solved positions and appends without a second header
+TEST(TrainingExportTest, Run_WritesAndAppends) {
+  std::string path = tempPath();
+  TrainingExporter exporter;
+  TrainingExporter::Options options;
+  options.threads = 3;
+  options.games = 40;
+  options.batchRecords = 16;
+  options.queueBatches = 2;
+
+  ASSERT_TRUE(exporter.run(path, options));
+  EXPECT_EQ(exporter.getGamesPlayed(), 40);
+  long firstRun = exporter.getRecordsWritten();
+  EXPECT_GE(firstRun, 40 * 5);
+
+  ASSERT_TRUE(exporter.run(path, options));
+
+  std::vector<TrainingRecord> records;
+  ASSERT_TRUE(TrainingExporter::readFile(path, records));
+  EXPECT_EQ(long(records.size()), 2 * firstRun);
+
+  for (const TrainingRecord& record : records) {
+    EXPECT_LT(record.bestMove, 9);
+    // The empty board is a draw with perfect play
+    if (record.ply == 0) {
+      EXPECT_EQ(record.value, 0);
+    }
+  }
+  std::remove(path.c_str());
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tictactoegame.h"
+#include "transpositiontable.h"
+
+// Stored data round-trips through the packed 64-bit word
+TEST(TranspositionTableTest, StoreProbe_RoundTrip) {
+  TranspositionTable table(1024);
+  table.store(0x1234567890ABCDEFULL, -987, 7, TT_LOWER, 42);
+
+  TTEntry entry;
+  ASSERT_TRUE(table.probe(0x1234567890ABCDEFULL, entry));
+  EXPECT_EQ(entry.score, -987);
+  EXPECT_EQ(entry.depth, 7);
+  EXPECT_EQ(entry.bound, TT_LOWER);
+  EXPECT_EQ(entry.bestMove, 42);
+}
+
+// A different key in the same bucket is a miss
+TEST(TranspositionTableTest, Probe_UnknownKeyMisses) {
+  TranspositionTable table(1024);
+  table.store(5, 10, 3, TT_EXACT, 1);
+  TTEntry entry;
+  EXPECT_FALSE(table.probe(5 + (1ULL << 40), entry));
+}
+
+// When a bucket is full, stale shallow entries are replaced first
+TEST(TranspositionTableTest, Store_ReplacesStaleEntries) {
+  TranspositionTable table(TranspositionTable::kBucketSize);  // one bucket
+  for (uint64_t key = 1; key <= TranspositionTable::kBucketSize; ++key)
+    table.store(key, 0, 10, TT_EXACT, -1);
+
+  for (int i = 0; i < 5; ++i) table.newSearch();
+  table.store(100, 0, 10, TT_EXACT, -1);  // evicts one aged entry
+  table.store(101, 0, 10, TT_EXACT, -1);  // must not evict key 100
+
+  TTEntry entry;
+  EXPECT_TRUE(table.probe(100, entry));
+  EXPECT_TRUE(table.probe(101, entry));
+}
+
+// Concurrent writers never produce an entry that fails verification
+TEST(TranspositionTableTest, ConcurrentAccess_NoTornEntries) {
+  TranspositionTable table(256);
+  std::vector<std::thread> threads;
+  std::atomic<bool> torn(false);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&table, &torn, t]() {
+      for (int i = 0; i < 100000; ++i) {
+        uint64_t key = (uint64_t(i % 512) << 8) | 1;
+        // Score is a function of the key, whatever thread wrote it
+        table.store(key, int(key % 1000), t + 1, TT_EXACT, 3);
+        TTEntry entry;
+        if (table.probe(key, entry) && entry.score != int(key % 1000))
+          torn = true;
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_FALSE(torn.load());
+}
+
+// Games sharing the process-wide table still play correctly
+TEST(TranspositionTableTest, SharedTable_GamesAgree) {
+  TicTacToeGame first;
+  TicTacToeGame second;
+  first.setTranspositionTable(&TranspositionTable::shared());
+  second.setTranspositionTable(&TranspositionTable::shared());
+  first.setDifficulty(3);
+  second.setDifficulty(3);
+  first.makeMove(0, 0, HUMAN);
+  first.makeMove(0, 1, HUMAN);
+  second.makeMove(0, 0, HUMAN);
+  second.makeMove(0, 1, HUMAN);
+
+  EXPECT_EQ(first.getAIMove(), std::make_pair(0, 2));
+  EXPECT_EQ(second.getAIMove(), std::make_pair(0, 2));
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "ultimatetictactoe.h"
+
+// First move may go anywhere
+TEST(UltimateTest, FirstMove_AnyBoardAllowed) {
+  UltimateTicTacToe game;
+  uint8_t moves[UltimateTicTacToe::kMaxMoves];
+  EXPECT_EQ(game.generateMoves(moves), 81);
+  EXPECT_EQ(game.getActiveBoard(), UltimateTicTacToe::kAnyBoard);
+}
+
+// The cell played selects the opponent's board
+TEST(UltimateTest, MakeMove_SendsOpponentToBoard) {
+  UltimateTicTacToe game;
+  EXPECT_TRUE(game.makeMove(4, 2));
+  EXPECT_EQ(game.getCell(4, 2), HUMAN);
+  EXPECT_EQ(game.getCurrentPlayer(), AI);
+  EXPECT_EQ(game.getActiveBoard(), 2);
+
+  EXPECT_FALSE(game.makeMove(4, 0));  // wrong board
+  EXPECT_TRUE(game.makeMove(2, 4));
+
+  uint8_t moves[UltimateTicTacToe::kMaxMoves];
+  EXPECT_EQ(game.generateMoves(moves), 8);  // board 4 minus one cell
+}
+
+// Occupied cells are rejected
+TEST(UltimateTest, MakeMove_OccupiedCellRejected) {
+  UltimateTicTacToe game;
+  game.makeMove(0, 0);
+  EXPECT_FALSE(game.makeMove(0, 0));
+}
+
+// Three in a row inside a sub-board wins it and frees the sender
+TEST(UltimateTest, SubBoardWin_ClosesBoard) {
+  UltimateTicTacToe game;
+  // X takes row 0 of board 0 while O answers inside boards 1 and 2
+  game.makeMove(0, 1);  // X -> O to board 1
+  game.makeMove(1, 0);  // O -> X to board 0
+  game.makeMove(0, 2);  // X -> O to board 2
+  game.makeMove(2, 0);  // O -> X to board 0
+  game.makeMove(0, 0);  // X wins board 0, O sent to board 0 (closed)
+
+  EXPECT_EQ(game.getBoardWinner(0), HUMAN);
+  EXPECT_EQ(game.getActiveBoard(), UltimateTicTacToe::kAnyBoard);
+  EXPECT_FALSE(game.makeMove(0, 4));
+}
+
+// Line lookup agrees with the eight winning masks
+TEST(UltimateTest, HasLine_DetectsLines) {
+  EXPECT_TRUE(UltimateTicTacToe::hasLine(0x007));
+  EXPECT_TRUE(UltimateTicTacToe::hasLine(0x054));
+  EXPECT_FALSE(UltimateTicTacToe::hasLine(0x00B));
+}
+
+// AI returns a legal move and is reproducible from a seed
+TEST(UltimateTest, AIMove_LegalAndSeeded) {
+  UltimateTicTacToe first;
+  UltimateTicTacToe second;
+  first.setSeed(42);
+  second.setSeed(42);
+
+  auto a = first.getAIMove(1000, 2000);
+  auto b = second.getAIMove(1000, 2000);
+  EXPECT_TRUE(first.isLegalMove(a.first, a.second));
+  EXPECT_EQ(a, b);
+  EXPECT_LE(first.getLastIterations(), 2000);
+}
+
+// Full random games terminate with a consistent result
+TEST(UltimateTest, SelfPlay_Terminates) {
+  UltimateTicTacToe game;
+  game.setSeed(7);
+  int plies = 0;
+  while (!game.isGameOver() && plies < 81) {
+    auto move = game.getAIMove(50, 200);
+    ASSERT_TRUE(game.makeMove(move.first, move.second));
+    ++plies;
+  }
+  EXPECT_TRUE(game.isGameOver());
+}
+
+int main() {
+  ::testing::InitGoogleTest();
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,10 @@ class TestUser : public QObject {
   void testGetWinRateZeroGames();
   void testAddGameToHistory();
   void testInlineGettersSetters();
+  void testSetGameCounts();
+  void testMoveEncodingRoundTrip();
+  void testMoveEncodingRejectsUnrepresentable();
+  void testMoveDecodingRejectsBadData();
 
  private:
   User* user;
@@ -66,6 +70,54 @@ void TestUser::testInlineGettersSetters() {
   QCOMPARE(user->getTotalGames(), 1);
 }
 
+void TestUser::testSetGameCounts() {
+  user->addWin();
+  user->setGameCounts(100000, 2, 3);
+  QCOMPARE(user->getGamesWon(), 100000);
+  QCOMPARE(user->getGamesLost(), 2);
+  QCOMPARE(user->getGamesTied(), 3);
+  QCOMPARE(user->getTotalGames(), 100005);
+}
+
+void TestUser::testMoveEncodingRoundTrip() {
+  QVector<GameMove> moves = {GameMove(0, 0, 1), GameMove(1, 1, 2),
+                             GameMove(0, 1, 1), GameMove(2, 2, 2),
+                             GameMove(0, 2, 1)};
+  QByteArray data = encodeMoves(moves);
+  QCOMPARE(data.size(), 5);
+
+  QVector<GameMove> decoded;
+  QVERIFY(decodeMoves(data, decoded));
+  QCOMPARE(decoded.size(), moves.size());
+  for (int i = 0; i < moves.size(); ++i) {
+    QCOMPARE(decoded[i].row, moves[i].row);
+    QCOMPARE(decoded[i].col, moves[i].col);
+    QCOMPARE(decoded[i].player, moves[i].player);
+  }
+
+  // O moving first and an empty list both survive
+  QVERIFY(decodeMoves(encodeMoves({GameMove(2, 2, 2)}), decoded));
+  QCOMPARE(decoded[0].player, 2);
+  QVERIFY(decodeMoves(encodeMoves(QVector<GameMove>()), decoded));
+  QVERIFY(decoded.isEmpty());
+}
+
+void TestUser::testMoveEncodingRejectsUnrepresentable() {
+  QVERIFY(encodeMoves({GameMove(0, 0, 1), GameMove(1, 1, 1)}).isEmpty());
+  QVERIFY(encodeMoves({GameMove(3, 0, 1)}).isEmpty());
+  QVERIFY(encodeMoves({GameMove(0, 0, 0)}).isEmpty());
+}
+
+void TestUser::testMoveDecodingRejectsBadData() {
+  QVector<GameMove> decoded;
+  QByteArray data = encodeMoves({GameMove(0, 0, 1), GameMove(1, 1, 2)});
+  QByteArray future = data;
+  future[0] = char(kMovesFormatVersion + 1);
+  QVERIFY(!decodeMoves(future, decoded));
+  QVERIFY(!decodeMoves(data.left(2), decoded));
+  QVERIFY(!decodeMoves(QByteArray(), decoded));
+}
+
 int main(int argc, char* argv[]) {
   QApplication app(argc, argv);
   TestUser test;
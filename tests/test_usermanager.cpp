@@ -1,4 +1,5 @@
 #include <QApplication>
+#include <QTemporaryDir>
 #include <QTest>
 #include <QtTest>
 
@@ -18,7 +19,13 @@ class TestUserManager : public QObject {
   void testUserManagerInitialization();
   void testDatabaseInitialization();
   void testTableCreation();
+  void testSchemaVersionCurrent();
+  void testLegacyDatabaseMigrated();
+  void testCorruptMovesKeptOnMigration();
+  void testHistoryQueriesUseIndex();
+  void testStatisticsMaintainedOnSave();
   void testDatabasePath();
+  void testManagersHaveOwnConnections();
 
   // User registration tests
   void testUserRegistration();
@@ -33,6 +40,7 @@ class TestUserManager : public QObject {
   void testUserLoginNonExistentUser();
   void testUserLoginWrongPassword();
   void testUserLoginUpdatesLastLogin();
+  void testUserLoginLoadsRecentGames();
 
   // User logout tests
   void testUserLogout();
@@ -63,6 +71,15 @@ class TestUserManager : public QObject {
   void testLoadAllGameHistory();
   void testGameHistoryLimit();
   void testGameHistoryOrdering();
+  void testGameHistoryAppendOnly();
+  void testGameHistoryPagination();
+  void testRecordedResultsWriteBehind();
+  void testHistoryPageIncludesJournaledGame();
+  void testSecondManagerLeavesJournalAlone();
+  void testJournalReplayedOnStartup();
+  void testGameAnalysisLoadedPerGame();
+  void testBatchCommitsTogether();
+  void testBatchRollback();
 
   // Move serialization tests
   void testMovesToString();
@@ -72,6 +89,8 @@ class TestUserManager : public QObject {
 
   // Database operations tests
   void testDatabaseConnection();
+  void testDatabaseTuningDefaults();
+  void testDatabaseTuningFromSettings();
   void testDatabaseTransactions();
   void testDatabaseErrorHandling();
 
@@ -123,6 +142,9 @@ void TestUserManager::cleanupTestDatabase() {
       QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
   QString dbPath = documentsPath + "/TicTacToe/tictactoe.db";
   QFile::remove(dbPath);
+  QFile::remove(dbPath + "-wal");
+  QFile::remove(dbPath + "-shm");
+  QFile::remove(documentsPath + "/TicTacToe/results.journal");
   QFile::remove(testDbPath);
 }
 
@@ -175,6 +197,208 @@ void TestUserManager::testTableCreation() {
   QVERIFY(!userExists);  // Should return false without crashing
 }
 
+void TestUserManager::testSchemaVersionCurrent() {
+  QCOMPARE(userManager->schemaVersion(), UserManager::kSchemaVersion);
+
+  // Reopening a current database leaves the version alone
+  delete userManager;
+  userManager = new UserManager();
+  QCOMPARE(userManager->schemaVersion(), UserManager::kSchemaVersion);
+}
+
+// History lists are read from the covering index, with no sort step
+void TestUserManager::testHistoryQueriesUseIndex() {
+  PooledConnection connection(userManager->databasePath());
+  QSqlQuery query(connection.database());
+  QVERIFY(query.exec(R"(
+        EXPLAIN QUERY PLAN
+        SELECT id, timestamp, opponent, result, game_mode, player_symbol
+        FROM game_history
+        WHERE user_id = (SELECT id FROM users WHERE username = 'x')
+        ORDER BY timestamp DESC, id DESC
+        LIMIT 5
+    )"));
+  QString plan;
+  while (query.next()) plan += query.value(3).toString() + "\n";
+  QVERIFY2(plan.contains("COVERING INDEX idx_game_history_user_time"),
+           qPrintable(plan));
+  QVERIFY2(!plan.contains("TEMP B-TREE"), qPrintable(plan));
+}
+
+// Aggregates follow each saved game without rereading the history
+void TestUserManager::testStatisticsMaintainedOnSave() {
+  createTestUser("statsuser", "statspass");
+  userManager->loginUser("statsuser", "statspass");
+
+  User* user = userManager->getCurrentUser();
+  const char* games[][2] = {{"AI", "Won"},  {"AI", "Won"}, {"Bob", "Lost"},
+                            {"AI", "Won"},  {"AI", "Won"}, {"AI", "Won"},
+                            {"Bob", "Tie"}, {"AI", "Won"}};
+  for (const auto& game : games) {
+    user->addGameToHistory(createTestGameRecord(game[0], game[1]));
+    if (game[0] == QString("Bob")) userManager->saveUserData();
+  }
+  userManager->saveUserData();
+
+  UserStatistics statistics = userManager->loadStatistics("statsuser");
+  QCOMPARE(statistics.byOpponent.size(), 2);
+  QCOMPARE(statistics.byOpponent[0].value, QString("AI"));
+  QCOMPARE(statistics.byOpponent[0].won, 6);
+  StatLine bob = UserStatistics::find(statistics.byOpponent, "Bob");
+  QCOMPARE(bob.lost, 1);
+  QCOMPARE(bob.tied, 1);
+  QCOMPARE(statistics.byMode.size(), 1);
+  QCOMPARE(statistics.byMode[0].total(), 8);
+  QCOMPARE(statistics.bySymbol[0].value, QString("X"));
+
+  QCOMPARE(statistics.streakResult, QString("Won"));
+  QCOMPARE(statistics.streakLength, 1);
+  QCOMPARE(statistics.bestWinStreak, 3);
+
+  QVERIFY(userManager->loadStatistics("nobody").byOpponent.isEmpty());
+
+  // A result still in the journal is counted too
+  userManager->recordStats(false, true, false);
+  userManager->recordGame(createTestGameRecord("Bob", "Lost"));
+  statistics = userManager->loadStatistics("statsuser");
+  QCOMPARE(UserStatistics::find(statistics.byOpponent, "Bob").lost, 2);
+  QCOMPARE(statistics.streakResult, QString("Lost"));
+}
+
+// A database from before versioning is adopted and brought up to date
+void TestUserManager::testLegacyDatabaseMigrated() {
+  delete userManager;
+  userManager = nullptr;
+  cleanupTestDatabase();
+
+  QString documentsPath =
+      QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+  {
+    // The original schema: user_version 0 and no move columns
+    QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy");
+    legacy.setDatabaseName(documentsPath + "/TicTacToe/tictactoe.db");
+    QVERIFY(legacy.open());
+    QSqlQuery query(legacy);
+    QVERIFY(query.exec(R"(
+        CREATE TABLE users (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            username TEXT UNIQUE NOT NULL,
+            password TEXT NOT NULL,
+            email TEXT,
+            last_login DATETIME,
+            games_won INTEGER DEFAULT 0,
+            games_lost INTEGER DEFAULT 0,
+            games_tied INTEGER DEFAULT 0,
+            created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+        )
+    )"));
+    QVERIFY(query.exec(R"(
+        CREATE TABLE game_history (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            username TEXT NOT NULL,
+            timestamp DATETIME NOT NULL,
+            opponent TEXT NOT NULL,
+            result TEXT NOT NULL,
+            game_mode TEXT NOT NULL,
+            player_symbol TEXT NOT NULL
+        )
+    )"));
+    QVERIFY(query.exec(
+        "INSERT INTO users (username, password) VALUES ('legacyuser', 'x')"));
+    QVERIFY(query.exec(
+        "INSERT INTO game_history (username, timestamp, opponent, result, "
+        "game_mode, player_symbol) VALUES ('legacyuser', "
+        "'2024-01-01T10:00:00', 'AI', 'Won', 'PvAI Easy', 'X')"));
+    legacy.close();
+  }
+  QSqlDatabase::removeDatabase("legacy");
+
+  userManager = new UserManager();
+  QCOMPARE(userManager->schemaVersion(), UserManager::kSchemaVersion);
+  QList<GameRecord> history =
+      userManager->loadAllGameHistoryFromDatabase("legacyuser");
+  QCOMPARE(history.size(), 1);
+  QCOMPARE(history.first().opponent, QString("AI"));
+  QVERIFY(history.first().moves.isEmpty());
+
+  UserStatistics statistics = userManager->loadStatistics("legacyuser");
+  QCOMPARE(UserStatistics::find(statistics.byOpponent, "AI").won, 1);
+  QCOMPARE(statistics.bestWinStreak, 1);
+
+  // Rows now reference the user by id
+  PooledConnection connection(userManager->databasePath());
+  QSqlQuery query(connection.database());
+  QVERIFY(query.exec("SELECT h.user_id = u.id FROM game_history h "
+                     "JOIN users u ON u.username = 'legacyuser'"));
+  QVERIFY(query.next());
+  QVERIFY(query.value(0).toBool());
+}
+
+// Text moves that do not parse strictly stay as text, without a blob
+void TestUserManager::testCorruptMovesKeptOnMigration() {
+  delete userManager;
+  userManager = nullptr;
+  cleanupTestDatabase();
+
+  QString documentsPath =
+      QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+  {
+    QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy");
+    legacy.setDatabaseName(documentsPath + "/TicTacToe/tictactoe.db");
+    QVERIFY(legacy.open());
+    QSqlQuery query(legacy);
+    QVERIFY(query.exec(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "username TEXT UNIQUE NOT NULL, password TEXT NOT NULL, email TEXT, "
+        "last_login DATETIME, games_won INTEGER DEFAULT 0, "
+        "games_lost INTEGER DEFAULT 0, games_tied INTEGER DEFAULT 0, "
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)"));
+    QVERIFY(query.exec(
+        "CREATE TABLE game_history (id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "username TEXT NOT NULL, timestamp DATETIME NOT NULL, "
+        "opponent TEXT NOT NULL, result TEXT NOT NULL, "
+        "game_mode TEXT NOT NULL, player_symbol TEXT NOT NULL, "
+        "moves_data TEXT)"));
+    QVERIFY(query.exec(
+        "INSERT INTO users (username, password) VALUES ('legacyuser', 'x')"));
+    QVERIFY(query.exec(
+        "INSERT INTO game_history (username, timestamp, opponent, result, "
+        "game_mode, player_symbol, moves_data) VALUES "
+        "('legacyuser', '2024-01-01T10:00:00', 'AI', 'Won', 'PvAI Easy', "
+        "'X', '0,0,1;1,1,2'), "
+        "('legacyuser', '2024-01-01T11:00:00', 'AI', 'Won', 'PvAI Easy', "
+        "'X', '0,0,1;x,1'), "
+        "('legacyuser', '2024-01-01T12:00:00', 'AI', 'Won', 'PvAI Easy', "
+        "'X', '0,0,1;1,1')"));
+    legacy.close();
+  }
+  QSqlDatabase::removeDatabase("legacy");
+
+  userManager = new UserManager();
+  PooledConnection connection(userManager->databasePath());
+  QSqlQuery query(connection.database());
+  QVERIFY(query.exec("SELECT moves_blob IS NOT NULL, moves_data "
+                     "FROM game_history ORDER BY timestamp"));
+  QVERIFY(query.next());
+  QVERIFY(query.value(0).toBool());
+  QVERIFY(query.value(1).isNull());
+  QVERIFY(query.next());
+  QVERIFY(!query.value(0).toBool());
+  QCOMPARE(query.value(1).toString(), QString("0,0,1;x,1"));
+  QVERIFY(query.next());
+  QVERIFY(!query.value(0).toBool());
+  QCOMPARE(query.value(1).toString(), QString("0,0,1;1,1"));
+}
+
+// Batches of two managers on one thread are separate transactions
+void TestUserManager::testManagersHaveOwnConnections() {
+  UserManager other;
+  QVERIFY(userManager->beginBatch());
+  QVERIFY(other.beginBatch());
+  QVERIFY(other.commitBatch());
+  QVERIFY(userManager->commitBatch());
+}
+
 // Test 4: Database Path
 void TestUserManager::testDatabasePath() {
   QString documentsPath =
@@ -298,6 +522,31 @@ void TestUserManager::testUserLoginUpdatesLastLogin() {
   QVERIFY(lastLogin >= yesterday);
 }
 
+// The single login query brings counters and the newest five games
+void TestUserManager::testUserLoginLoadsRecentGames() {
+  createTestUser("recentuser", "recentpass");
+  userManager->loginUser("recentuser", "recentpass");
+  User* user = userManager->getCurrentUser();
+  for (int i = 0; i < 7; i++) {
+    user->addWin();
+    user->addGameToHistory(
+        createTestGameRecord(QString("RecentOpponent%1").arg(i), "Won"));
+  }
+  user->addTie();
+  userManager->logoutUser();
+
+  QVERIFY(!userManager->loginUser("recentuser", "wrongpass"));
+  QVERIFY(userManager->loginUser("recentuser", "recentpass"));
+  user = userManager->getCurrentUser();
+  QCOMPARE(user->getGamesWon(), 7);
+  QCOMPARE(user->getGamesTied(), 1);
+  QList<GameRecord> history = user->getGameHistory();
+  QCOMPARE(history.size(), 5);
+  QCOMPARE(history.first().opponent, QString("RecentOpponent6"));
+  QCOMPARE(history.last().opponent, QString("RecentOpponent2"));
+  QCOMPARE(history.first().moves.size(), 3);
+}
+
 // Test 15: User Logout
 void TestUserManager::testUserLogout() {
   createTestUser("logoutuser", "logoutpass");
@@ -594,6 +843,249 @@ void TestUserManager::testLoadAllGameHistory() {
   QCOMPARE(allHistory.size(), 7);
 }
 
+// Saving again inserts only new games and keeps rows not loaded at login
+void TestUserManager::testGameHistoryAppendOnly() {
+  createTestUser("appenduser", "appendpass");
+  userManager->loginUser("appenduser", "appendpass");
+
+  User* user = userManager->getCurrentUser();
+  for (int i = 0; i < 7; i++) {
+    user->addGameToHistory(
+        createTestGameRecord(QString("AppendOpponent%1").arg(i), "Won"));
+  }
+  userManager->saveUserData();
+  userManager->saveUserData();
+  QCOMPARE(userManager->loadAllGameHistoryFromDatabase("appenduser").size(),
+           7);
+  for (const GameRecord& record : user->getGameHistory()) {
+    QVERIFY(record.id != 0);
+  }
+
+  // Login loads only the last 5 games; the other 2 must survive a save
+  userManager->logoutUser();
+  userManager->loginUser("appenduser", "appendpass");
+  user = userManager->getCurrentUser();
+  QCOMPARE(user->getGameHistory().size(), 5);
+  user->addGameToHistory(createTestGameRecord("AppendOpponent7", "Lost"));
+  userManager->saveUserData();
+
+  QList<GameRecord> allHistory =
+      userManager->loadAllGameHistoryFromDatabase("appenduser");
+  QCOMPARE(allHistory.size(), 8);
+  QVERIFY(user->getGameHistory().first().id != 0);
+}
+
+// Pages follow (timestamp, id) with no gaps or repeats, even across ties
+void TestUserManager::testGameHistoryPagination() {
+  createTestUser("pageuser", "pagepass");
+  userManager->loginUser("pageuser", "pagepass");
+
+  User* user = userManager->getCurrentUser();
+  QDateTime sameTime = QDateTime::currentDateTime();
+  for (int i = 0; i < 7; i++) {
+    GameRecord record =
+        createTestGameRecord(QString("PageOpponent%1").arg(i), "Won");
+    record.timestamp = sameTime;
+    user->addGameToHistory(record);
+  }
+  userManager->saveUserData();
+
+  HistoryCursor cursor;
+  QList<GameRecord> first =
+      userManager->loadGameHistoryPage("pageuser", cursor, 3);
+  QList<GameRecord> second =
+      userManager->loadGameHistoryPage("pageuser", cursor, 3);
+  QList<GameRecord> third =
+      userManager->loadGameHistoryPage("pageuser", cursor, 3);
+  QCOMPARE(first.size(), 3);
+  QCOMPARE(second.size(), 3);
+  QCOMPARE(third.size(), 1);
+  QVERIFY(userManager->loadGameHistoryPage("pageuser", cursor, 3).isEmpty());
+
+  // Newest first: equal timestamps fall back to descending row id
+  QList<GameRecord> pages = first + second + third;
+  for (int i = 1; i < pages.size(); i++) {
+    QVERIFY(pages[i].id < pages[i - 1].id);
+  }
+  QCOMPARE(pages.first().opponent, QString("PageOpponent6"));
+  QVERIFY(pages.first().moves.isEmpty());
+
+  QVector<GameMove> moves = userManager->loadGameMoves(pages.first().id);
+  QCOMPARE(moves.size(), 3);
+  QCOMPARE(moves[1].row, 1);
+  QCOMPARE(moves[1].player, 2);
+}
+
+// Recorded results stay in the journal until a flush writes them together
+void TestUserManager::testRecordedResultsWriteBehind() {
+  createTestUser("behinduser", "behindpass");
+  userManager->loginUser("behinduser", "behindpass");
+
+  userManager->recordStats(true, false, false);
+  userManager->recordGame(createTestGameRecord("BehindOpponent", "Won"));
+  QCOMPARE(userManager->getCurrentUser()->getGamesWon(), 1);
+  QVERIFY(userManager->loadAllGameHistoryFromDatabase("behinduser").isEmpty());
+
+  QVERIFY(userManager->flushJournal());
+  QList<GameRecord> saved =
+      userManager->loadAllGameHistoryFromDatabase("behinduser");
+  QCOMPARE(saved.size(), 1);
+  QCOMPARE(saved.first().opponent, QString("BehindOpponent"));
+
+  // Flushing again must not insert the game twice
+  QVERIFY(userManager->flushJournal());
+  userManager->saveUserData();
+  QCOMPARE(userManager->loadAllGameHistoryFromDatabase("behinduser").size(),
+           1);
+}
+
+// The first history page shows a game that is still only in the journal
+void TestUserManager::testHistoryPageIncludesJournaledGame() {
+  createTestUser("journalpageuser", "journalpagepass");
+  userManager->loginUser("journalpageuser", "journalpagepass");
+
+  userManager->recordGame(createTestGameRecord("JustPlayed", "Won"));
+  HistoryCursor cursor;
+  QList<GameRecord> page =
+      userManager->loadGameHistoryPage("journalpageuser", cursor, 10);
+  QCOMPARE(page.size(), 1);
+  QCOMPARE(page.first().opponent, QString("JustPlayed"));
+}
+
+// A manager that cannot open the journal saves directly and leaves the
+// journal position of the manager that owns the file untouched
+void TestUserManager::testSecondManagerLeavesJournalAlone() {
+  createTestUser("owneruser", "ownerpass");
+  createTestUser("otheruser", "otherpass");
+  userManager->loginUser("owneruser", "ownerpass");
+  userManager->recordGame(createTestGameRecord("OwnerOpponent1", "Won"));
+  userManager->recordGame(createTestGameRecord("OwnerOpponent2", "Won"));
+  QVERIFY(userManager->flushJournal());
+
+  PooledConnection connection(userManager->databasePath());
+  auto appliedSequence = [&connection]() {
+    QSqlQuery query(connection.database());
+    if (!query.exec("SELECT applied_sequence FROM journal_state") ||
+        !query.next())
+      return qint64(-1);
+    return query.value(0).toLongLong();
+  };
+  qint64 applied = appliedSequence();
+  QVERIFY(applied >= 2);
+  userManager->recordGame(createTestGameRecord("OwnerPending", "Won"));
+
+  {
+    UserManager other;  // the journal file is already in use
+    QVERIFY(other.loginUser("otheruser", "otherpass"));
+    other.recordGame(createTestGameRecord("OtherOpponent", "Won"));
+    QCOMPARE(other.loadAllGameHistoryFromDatabase("otheruser").size(), 1);
+  }
+  QCOMPARE(appliedSequence(), applied);
+
+  QVERIFY(userManager->flushJournal());
+  QVERIFY(appliedSequence() > applied);
+  QCOMPARE(userManager->loadAllGameHistoryFromDatabase("owneruser").size(), 3);
+}
+
+// Each analyzed game's result can be read back on its own
+void TestUserManager::testGameAnalysisLoadedPerGame() {
+  createTestUser("analysisuser", "analysispass");
+  userManager->loginUser("analysisuser", "analysispass");
+  userManager->recordGame(createTestGameRecord("Analyzed", "Won"));
+  QVERIFY(userManager->flushJournal());
+
+  QList<GameRecord> games =
+      userManager->loadAllGameHistoryFromDatabase("analysisuser");
+  QCOMPARE(games.size(), 1);
+  qint64 id = games.first().id;
+  QCOMPARE(userManager->loadGameAnalysis(id).gameId, qint64(0));
+
+  QVERIFY(userManager->analyzeGameHistory(1) >= 1);
+  GameAnalysis single = userManager->loadGameAnalysis(id);
+  QVector<GameAnalysis> all = userManager->loadGameAnalysis("analysisuser");
+  QCOMPARE(all.size(), 1);
+  QCOMPARE(single.gameId, id);
+  QCOMPARE(single.valid, all.first().valid);
+  QCOMPARE(single.accuracy, all.first().accuracy);
+  QCOMPARE(single.qualityString(), all.first().qualityString());
+}
+
+// Results journaled before a crash are written when the database reopens
+void TestUserManager::testJournalReplayedOnStartup() {
+  createTestUser("replayuser", "replaypass");
+  delete userManager;
+  userManager = nullptr;
+
+  // Sequences far past anything the earlier tests applied
+  QString documentsPath =
+      QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+  ResultJournal journal;
+  QVERIFY(journal.open(documentsPath + "/TicTacToe/results.journal",
+                       1000000000));
+  JournalEntry entry;
+  entry.username = "replayuser";
+  entry.won = 1;
+  entry.hasGame = true;
+  entry.game = createTestGameRecord("ReplayOpponent", "Won");
+  QVERIFY(journal.append(entry));
+  journal.close();
+
+  userManager = new UserManager();
+  QVERIFY(userManager->loginUser("replayuser", "replaypass"));
+  QCOMPARE(userManager->getCurrentUser()->getGamesWon(), 1);
+  QList<GameRecord> saved =
+      userManager->loadAllGameHistoryFromDatabase("replayuser");
+  QCOMPARE(saved.size(), 1);
+  QCOMPARE(saved.first().moves.size(), 3);
+
+  // Replayed once only
+  delete userManager;
+  userManager = new UserManager();
+  QVERIFY(userManager->loginUser("replayuser", "replaypass"));
+  QCOMPARE(userManager->getCurrentUser()->getGamesWon(), 1);
+}
+
+// Nested saves inside a batch reach the database at the outer commit
+void TestUserManager::testBatchCommitsTogether() {
+  createTestUser("batchuser", "batchpass");
+  userManager->loginUser("batchuser", "batchpass");
+  User* user = userManager->getCurrentUser();
+
+  QVERIFY(userManager->beginBatch());
+  for (int i = 0; i < 3; i++) {
+    user->addWin();
+    user->addGameToHistory(
+        createTestGameRecord(QString("BatchOpponent%1").arg(i), "Won"));
+    userManager->saveUserData();
+  }
+  QVERIFY(userManager->commitBatch());
+
+  QCOMPARE(userManager->loadAllGameHistoryFromDatabase("batchuser").size(), 3);
+  userManager->logoutUser();
+  userManager->loginUser("batchuser", "batchpass");
+  QCOMPARE(userManager->getCurrentUser()->getGamesWon(), 3);
+}
+
+// A rolled-back batch leaves no rows and its games are saved next time
+void TestUserManager::testBatchRollback() {
+  createTestUser("rollbackuser", "rollbackpass");
+  userManager->loginUser("rollbackuser", "rollbackpass");
+  User* user = userManager->getCurrentUser();
+
+  QVERIFY(userManager->beginBatch());
+  user->addGameToHistory(createTestGameRecord("RollbackOpponent", "Lost"));
+  userManager->saveUserData();
+  userManager->rollbackBatch();
+
+  QCOMPARE(
+      userManager->loadAllGameHistoryFromDatabase("rollbackuser").size(), 0);
+  QCOMPARE(user->getGameHistory().first().id, qint64(0));
+
+  userManager->saveUserData();
+  QCOMPARE(
+      userManager->loadAllGameHistoryFromDatabase("rollbackuser").size(), 1);
+}
+
 // Test 33: Game History Limit
 void TestUserManager::testGameHistoryLimit() {
   createTestUser("limituser", "limitpass");
@@ -777,6 +1269,38 @@ void TestUserManager::testDatabaseConnection() {
   QVERIFY(userManager->userExists("connectiontest"));
 }
 
+// The default profile is applied on open
+void TestUserManager::testDatabaseTuningDefaults() {
+  QString report = userManager->tuningReport();
+  QVERIFY(report.contains("journal_mode=wal"));
+  QVERIFY(report.contains("synchronous=1"));  // NORMAL
+  QVERIFY(report.contains("cache_size=-8192"));
+  QVERIFY(report.contains("temp_store=2"));  // MEMORY
+  QVERIFY(report.contains("busy_timeout=5000"));
+}
+
+// Overrides come from the [sqlite] group; unknown values keep defaults
+void TestUserManager::testDatabaseTuningFromSettings() {
+  QTemporaryDir dir;
+  QString path = dir.path() + "/sqlite.ini";
+  {
+    QSettings settings(path, QSettings::IniFormat);
+    settings.beginGroup("sqlite");
+    settings.setValue("synchronous", "full");
+    settings.setValue("cache_size_kib", 2048);
+    settings.setValue("journal_mode", "WAL; DROP TABLE users");
+  }
+
+  DatabaseTuning tuning = DatabaseTuning::fromSettings(path);
+  QCOMPARE(tuning.synchronous, QString("FULL"));
+  QCOMPARE(tuning.cacheSizeKiB, 2048);
+  QCOMPARE(tuning.journalMode, QString("WAL"));
+
+  QVERIFY(userManager->applyTuning(tuning));
+  QVERIFY(userManager->tuningReport().contains("synchronous=2"));
+  QVERIFY(userManager->tuningReport().contains("cache_size=-2048"));
+}
+
 // Test 40: Database Transactions
 void TestUserManager::testDatabaseTransactions() {
   // Test multiple operations in sequence